@@ -1,10 +1,9 @@
 #pragma once
 
-#include <ostream>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
-class CarWash;
-
 /**
  * @brief Defines how rare an achievement is, typically used for UI/ordering.
  */
@@ -39,6 +38,20 @@ enum class AchievementEventType {
     StructureChanged /**< Services/bays structure changed. */
 };
 
+/**
+ * @brief Number of AchievementEventType values.
+ */
+inline constexpr std::size_t ACHIEVEMENT_EVENT_TYPES = 6;
+
+/**
+ * @brief Bit of an event type inside an event mask.
+ */
+constexpr std::uint32_t eventBit(AchievementEventType t) noexcept {
+    return std::uint32_t{1} << static_cast<unsigned>(t);
+}
+
+inline constexpr std::uint32_t ALL_ACHIEVEMENT_EVENTS = (std::uint32_t{1} << ACHIEVEMENT_EVENT_TYPES) - 1;
+
 /**
  * @brief Unified event payload provided to achievements.
  *
@@ -50,8 +63,9 @@ struct AchievementEvent {
     AchievementEventType type{AchievementEventType::Served};
 
     int cars{0}; /**< Served cars for Served events. */
-    double satisfaction{0.0}; /**< Satisfaction for Served events. */
+    double satisfactionSum{0.0}; /**< Satisfaction summed over the served cars (average = sum / cars). */
     double revenue{0.0}; /**< Revenue for Served events. */
+    int lost{1}; /**< Lost customers for Lost events (more than one when coalesced). */
 
     int day{0}; /**< Current day index for DayEnd events. */
     int dailyServed{0}; /**< Total cars served during the day for DayEnd events. */
@@ -65,144 +79,3 @@ struct AchievementEvent {
 
     int upgradeId{0}; /**< Upgrade id for BuyUpgrade events. */
 };
-
-/**
- * @brief Abstract base class for a single achievement.
- *
- * Achievements are stateful observers of gameplay events. Each achievement defines
- * its own logic inside onEvent(), updates progress, and unlocks itself when reaching
- * the target threshold. Unlocking can apply a reward to the CarWash game state.
- */
-class Achievement {
-protected:
-    std::string id_;
-    std::string name_;
-    std::string desc_;
-    AchievementCategory category_{AchievementCategory::Operations};
-    AchievementRarity rarity_{AchievementRarity::Common};
-    bool hidden_{false};
-    bool unlocked_{false};
-
-    int progress_{0};
-    int target_{1};
-    AchievementReward reward_{};
-
-public:
-    /**
-     * @brief Constructs an achievement with metadata, target, and reward.
-     *
-     * @param id Stable identifier used for saving / indexing.
-     * @param name Display name shown in UI (may be hidden if hidden=true and locked).
-     * @param desc Description shown in UI (may be hidden if hidden=true and locked).
-     * @param cat Achievement category.
-     * @param rar Achievement rarity.
-     * @param target Progress threshold required to unlock.
-     * @param reward Reward payload applied when unlocking.
-     * @param hidden If true, name/description are obscured until unlocked.
-     */
-    Achievement(std::string id, std::string name, std::string desc,
-                AchievementCategory cat, AchievementRarity rar,
-                int target, const AchievementReward &reward, bool hidden = false)
-        : id_(std::move(id)),
-          name_(std::move(name)),
-          desc_(std::move(desc)),
-          category_(cat),
-          rarity_(rar),
-          hidden_(hidden),
-          target_(target),
-          reward_(reward) {
-    }
-
-    /**
-     * @brief Virtual destructor for polymorphic deletion.
-     */
-    virtual ~Achievement() = default;
-
-    /**
-     * @brief Returns the stable identifier of the achievement.
-     */
-    const std::string &id() const noexcept { return id_; }
-
-    /**
-     * @brief Returns whether the achievement has been unlocked.
-     */
-    bool unlocked() const noexcept { return unlocked_; }
-
-    /**
-     * @brief Returns whether the achievement is hidden until unlocked.
-     */
-    bool hidden() const noexcept { return hidden_; }
-
-    /**
-     * @brief Returns current progress value.
-     */
-    int progress() const noexcept { return progress_; }
-
-    /**
-     * @brief Returns target progress required to unlock.
-     */
-    int target() const noexcept { return target_; }
-
-    /**
-     * @brief Returns achievement category.
-     */
-    AchievementCategory category() const noexcept { return category_; }
-
-    /**
-     * @brief Returns achievement rarity.
-     */
-    AchievementRarity rarity() const noexcept { return rarity_; }
-
-    /**
-     * @brief Returns a UI-safe name (masked if hidden and not unlocked).
-     */
-    std::string displayName() const {
-        if (hidden_ && !unlocked_) return "???";
-        return name_;
-    }
-
-    /**
-     * @brief Returns a UI-safe description (masked if hidden and not unlocked).
-     */
-    std::string displayDesc() const {
-        if (hidden_ && !unlocked_) return "Hidden achievement";
-        return desc_;
-    }
-
-    /**
-     * @brief Event handler invoked by the achievement manager.
-     *
-     * Derived classes implement their condition/progress logic here.
-     *
-     * @param game Mutable game state, enabling reward application on unlock.
-     * @param ev Event payload describing what just happened.
-     */
-    virtual void onEvent(CarWash &game, const AchievementEvent &ev) = 0;
-
-    /**
-     * @brief Marks the achievement as unlocked and applies reward (once).
-     *
-     * If the achievement is already unlocked, this function has no effect.
-     *
-     * @param game Game state to which the reward is applied.
-     */
-    void unlock(CarWash &game);
-
-    /**
-     * @brief Prints achievement details for UI/console output.
-     *
-     * Output respects hidden status via displayName()/displayDesc().
-     *
-     * @param os Output stream.
-     */
-    void print(std::ostream &os) const;
-};
-
-/**
- * @brief Stream output helper for achievements.
- *
- * @param os Output stream.
- * @param a Achievement to print.
- * @return Reference to the output stream.
- */
-std::ostream &operator<<(std::ostream &os, const Achievement &a);
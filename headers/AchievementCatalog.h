@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Achievement.h"
+
+/**
+ * @brief Rule an achievement definition is evaluated with.
+ */
+enum class AchievementKind : std::uint8_t {
+    Threshold, /**< A game metric reaches the threshold. */
+    PerfectDay, /**< A day ends with no lost customers and at least threshold served. */
+    RevenueDay, /**< A day ends with at least threshold revenue. */
+    AvgSatDay /**< A day ends with an average satisfaction of at least threshold. */
+};
+
+/**
+ * @brief Game metric watched by threshold achievements.
+ */
+enum class AchievementMetric : std::uint8_t {
+    CarsServedTotal,
+    CashTotal,
+    ReputationScore, /**< In hundredths (4.00 -> 400). */
+    BaysCount,
+    ServicesCount,
+    UpgradesBought,
+    SuppliesPacks,
+    PerfectDays,
+    None /**< Day-end kinds. */
+};
+
+/**
+ * @brief One immutable achievement definition (a row of achievements.def).
+ */
+struct AchievementDef {
+    std::string_view id;
+    std::string_view name;
+    std::string_view desc;
+    AchievementCategory category{AchievementCategory::Operations};
+    AchievementRarity rarity{AchievementRarity::Common};
+    AchievementKind kind{AchievementKind::Threshold};
+    AchievementMetric metric{AchievementMetric::None};
+    double threshold{1.0};
+    AchievementReward reward{};
+    bool hidden{false};
+};
+
+/**
+ * @brief The immutable achievement definitions and their dispatch index, shared by all games.
+ *
+ * Definitions come from achievements.def, a list of ACHIEVEMENT(...) rows. The file is
+ * parsed once into a flat table whose strings point into a single owned buffer. With the
+ * EMBED_ACHIEVEMENTS build option the same file is compiled in as a constexpr array
+ * instead, so the executable needs no data file. Either way, --achievements FILE replaces
+ * the catalog at startup.
+ *
+ * The catalog also groups the definitions into dispatch slots: every threshold definition
+ * on one metric joins one ladder sorted by threshold, and every other definition is a slot
+ * of its own. Each slot records the event types that can change its outcome. Games only
+ * hold a shared pointer to the catalog plus their own unlock bits and progress (see
+ * AchievementManager).
+ *
+ * Replace the active catalog (setActive) before any game is created, and never while
+ * simulations run on other threads. Games created earlier keep the catalog they were
+ * built with.
+ */
+class AchievementCatalog {
+public:
+    /**
+     * @brief One dispatch unit: a standalone definition or a threshold ladder.
+     */
+    struct Slot {
+        std::vector<std::uint32_t> rungs; /**< Definition indices, by ascending threshold (one if standalone). */
+        std::uint32_t events{0}; /**< Mask of eventBit() values the slot reacts to. */
+    };
+
+private:
+    std::unique_ptr<char[]> text_; /**< Owns the strings of a parsed catalog (empty when embedded). */
+    std::vector<AchievementDef> owned_;
+    std::span<const AchievementDef> defs_;
+
+    std::vector<Slot> slots_; /**< In catalog order of their first definition. */
+    std::vector<std::uint32_t> slotOf_; /**< Slot of every definition. */
+    std::vector<std::pair<std::string_view, std::uint32_t> > byId_; /**< Sorted by id. */
+
+    void buildIndex();
+
+public:
+    static constexpr const char *DEFAULT_FILE = "achievements.def";
+
+    AchievementCatalog() = default;
+
+    AchievementCatalog(AchievementCatalog &&) noexcept = default;
+
+    AchievementCatalog &operator=(AchievementCatalog &&) noexcept = default;
+
+    AchievementCatalog(const AchievementCatalog &) = delete;
+
+    AchievementCatalog &operator=(const AchievementCatalog &) = delete;
+
+    /**
+     * @brief Parses the text of a definition file.
+     *
+     * @param text File contents.
+     * @param source Name used in error messages.
+     * @throws CatalogException On a malformed row, an unknown enum name or a duplicate id.
+     */
+    static AchievementCatalog parse(std::string_view text, const std::string &source = DEFAULT_FILE);
+
+    /**
+     * @throws CatalogException If the file cannot be read or is malformed.
+     */
+    static AchievementCatalog fromFile(const std::string &path);
+
+    /**
+     * @brief The catalog compiled into the executable (empty without EMBED_ACHIEVEMENTS).
+     */
+    static AchievementCatalog embedded();
+
+    /**
+     * @brief Whether this build embeds achievements.def.
+     */
+    static bool hasEmbedded() noexcept;
+
+    /**
+     * @brief Catalog new games use: the embedded one, otherwise DEFAULT_FILE (loaded on first use).
+     *
+     * @throws CatalogException If the default file has to be loaded and cannot be.
+     */
+    static std::shared_ptr<const AchievementCatalog> active();
+
+    static void setActive(AchievementCatalog catalog);
+
+    /**
+     * @brief Event types after which a definition's outcome can have changed.
+     *
+     * Counters are only re-checked on the events that bump them; levels that start non-zero
+     * or move outside events (cash, reputation, structure) are polled on every event.
+     */
+    static std::uint32_t eventsOf(const AchievementDef &def) noexcept;
+
+    [[nodiscard]] std::span<const AchievementDef> defs() const noexcept { return defs_; }
+
+    [[nodiscard]] const AchievementDef &def(size_t i) const noexcept { return defs_[i]; }
+
+    [[nodiscard]] size_t size() const noexcept { return defs_.size(); }
+
+    [[nodiscard]] const std::vector<Slot> &slots() const noexcept { return slots_; }
+
+    [[nodiscard]] std::uint32_t slotOf(size_t i) const noexcept { return slotOf_[i]; }
+
+    /**
+     * @brief Index of the definition with this id, or -1.
+     */
+    [[nodiscard]] int find(std::string_view id) const noexcept;
+};
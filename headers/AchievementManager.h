@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 #include <string>
@@ -7,21 +10,157 @@
 
 #include "Achievement.h"
 
+class AchievementCatalog;
 class CarWash;
+class BinaryWriter;
+class BinaryReader;
 
+/**
+ * @brief Per-game achievement state over a shared, immutable AchievementCatalog.
+ *
+ * Definitions (names, rewards, thresholds, dispatch slots) live once in the catalog and are
+ * shared by every game; a manager only keeps an unlock bitset, a packed progress array and,
+ * per event type, the bitset of slots still listening to it. Creating or copying a game
+ * therefore allocates a handful of small vectors instead of one object per achievement.
+ *
+ * Events only reach the slots subscribed to their type (see AchievementCatalog::eventsOf),
+ * in catalog order. Of a threshold ladder only the lowest locked rung is evaluated;
+ * finished slots leave the live bitsets, so an event costs O(live slots) instead of
+ * O(catalog). While coalescing, a customer only decrements the headroom counters.
+ */
 class AchievementManager {
-    std::vector<std::unique_ptr<Achievement> > list_;
+    std::shared_ptr<const AchievementCatalog> catalog_;
+
+    std::vector<std::uint64_t> unlocked_; /**< Bit i: definition i is unlocked. */
+    std::vector<std::int32_t> progress_; /**< Progress of every definition. */
+    std::vector<std::uint16_t> active_; /**< Per slot: first rung that may still be locked. */
+    std::array<std::vector<std::uint64_t>, ACHIEVEMENT_EVENT_TYPES> live_; /**< Unfinished slots per event type. */
+
     int totalSuppliesPacks_{0};
     int totalUpgrades_{0};
     int perfectDays_{0};
 
-    void dispatch(CarWash &game, const AchievementEvent &ev) const;
+    /**
+     * @brief Served / lost outcomes collected while coalescing, not yet dispatched.
+     */
+    struct Pending {
+        int cars{0};
+        double satisfactionSum{0.0};
+        double revenue{0.0};
+        int lost{0};
+    };
+
+    /**
+     * @brief What is left before a live Served / Lost ladder could unlock, while coalescing.
+     *
+     * Only served cars and cash move during an hour: bays and services change through commands,
+     * the reputation once the hour is over. The flags mark ladders whose rung already holds.
+     */
+    struct Headroom {
+        int cars{std::numeric_limits<int>::max()};
+        double cash{std::numeric_limits<double>::infinity()};
+        bool served{false};
+        bool lost{false};
+    };
+
+    bool coalescing_{false};
+    Pending pending_{};
+    Headroom headroom_{};
+
+    [[nodiscard]] bool isUnlocked(size_t i) const noexcept { return (unlocked_[i / 64] >> (i % 64)) & 1u; }
+
+    [[nodiscard]] bool slotDone(size_t s) const noexcept;
+
+    /**
+     * @brief Whether a live slot of the given type could unlock on an event now.
+     */
+    [[nodiscard]] bool anyDue(const CarWash &game, AchievementEventType type) const;
+
+    /**
+     * @brief Recomputes headroom_ from the game state; O(live Served / Lost slots).
+     */
+    void armHeadroom(const CarWash &game);
+
+    /**
+     * @brief Flushes the pending outcomes if a slot of the type could unlock, then re-arms.
+     */
+    void recheck(CarWash &game, AchievementEventType type);
+
+    /**
+     * @brief Dispatches the pending outcomes as one Served and one Lost event.
+     */
+    void flushPending(CarWash &game);
+
+    void route(CarWash &game, const AchievementEvent &ev);
+
+    /**
+     * @brief Recomputes the active rungs and the live bitsets from the unlock state.
+     */
+    void buildIndex();
+
+    /**
+     * @brief Evaluates the active rung(s) of a slot; moves up the ladder while rungs unlock.
+     */
+    void evaluate(size_t slot, CarWash &game, const AchievementEvent &ev);
+
+    /**
+     * @brief Updates the progress of definition i and unlocks it if its condition holds.
+     */
+    void check(size_t i, CarWash &game, const AchievementEvent &ev);
+
+    /**
+     * @brief Whether an event dispatched now could unlock definition i.
+     *
+     * Day-end kinds cannot tell and answer true.
+     */
+    [[nodiscard]] bool couldUnlock(size_t i, const CarWash &game) const;
+
+    /**
+     * @brief Marks definition i as unlocked and applies its reward to the game.
+     */
+    void unlock(size_t i, CarWash &game);
+
+    /**
+     * @brief Progress of definition i; rungs above the active one share its progress.
+     */
+    [[nodiscard]] int shownProgress(size_t i) const;
 
 public:
+    /**
+     * @brief Manager over the active catalog (AchievementCatalog::active()).
+     */
     AchievementManager();
 
+    explicit AchievementManager(std::shared_ptr<const AchievementCatalog> catalog);
+
+    /**
+     * @brief Copies the per-game state; the catalog stays shared.
+     */
+    AchievementManager(const AchievementManager &) = default;
+
+    AchievementManager &operator=(const AchievementManager &) = default;
+
+    AchievementManager(AchievementManager &&) noexcept = default;
+
+    AchievementManager &operator=(AchievementManager &&) noexcept = default;
+
     void dispatch(CarWash &game, const AchievementEvent &ev);
 
+    /**
+     * @brief Starts summing Served / Lost outcomes instead of dispatching them one by one.
+     *
+     * Pending outcomes are dispatched as one aggregate event by endCoalescing(), before any
+     * other event, or as soon as a live slot could unlock, so unlocks and rewards happen at
+     * the same customer as with per-event dispatch. The headroom to the next rungs is
+     * computed here once; each outcome then only decrements it.
+     */
+    void beginCoalescing(const CarWash &game);
+
+    /**
+     * @brief Dispatches the pending outcomes and returns to per-event dispatch.
+     */
+    void endCoalescing(CarWash &game);
+
     void onServed(CarWash &game, int cars, double satisfaction, double revenue);
 
     void onLost(CarWash &game);
@@ -38,5 +177,15 @@ public:
     int totalUpgrades() const noexcept { return totalUpgrades_; }
     int perfectDays() const noexcept { return perfectDays_; }
 
+    /**
+     * @brief Writes counters and the unlock state / progress of every achievement (by id).
+     */
+    void save(BinaryWriter &w) const;
+
+    /**
+     * @brief Restores the state written by save(); ids missing from the file keep their defaults.
+     */
+    void load(BinaryReader &r);
+
     void print(std::ostream &os) const;
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "WashService.h"
+
+/**
+ * @brief Earliest-available wash bay per service kind.
+ *
+ * Keeps one indexed binary min-heap of bay indices per ServiceKind, ordered by the minute
+ * at which the bay becomes free (ties go to the lower bay index). A bay sits in the heap
+ * of every kind it can run. Finding the best bay is O(1) and updating a bay after a
+ * booking is O(log B) per capability, so the cost stays flat with hundreds of bays.
+ */
+class BayAvailabilityIndex {
+    /**
+     * @brief Binary min-heap over bay indices that can move an element in place.
+     */
+    class Heap {
+        std::vector<int> heap_; /**< Bay indices in heap order. */
+        std::vector<int> pos_; /**< Position of each bay in heap_, or -1 if absent. */
+
+        bool less(int a, int b, const std::vector<int> &avail) const noexcept;
+
+        void siftUp(size_t i, const std::vector<int> &avail);
+
+        void siftDown(size_t i, const std::vector<int> &avail);
+
+        void place(size_t i, int bay);
+
+    public:
+        void clear();
+
+        void insert(int bay, const std::vector<int> &avail);
+
+        void update(int bay, const std::vector<int> &avail);
+
+        [[nodiscard]] bool empty() const noexcept { return heap_.empty(); }
+        [[nodiscard]] int top() const noexcept { return heap_.front(); }
+    };
+
+    static constexpr size_t kKinds = static_cast<size_t>(ServiceKind::Custom) + 1;
+
+    std::array<Heap, kKinds> heaps_;
+    std::vector<int> avail_; /**< Free-at minute per bay index. */
+    std::vector<ServiceKindMask> caps_; /**< Capabilities per bay index. */
+
+public:
+    /**
+     * @brief Removes every bay.
+     */
+    void clear();
+
+    /**
+     * @brief Registers bay number size() with its capabilities and free-at minute.
+     */
+    void add(ServiceKindMask caps, int availMin);
+
+    /**
+     * @brief Moves a bay to its new free-at minute in every heap that contains it.
+     */
+    void update(int bay, int availMin);
+
+    /**
+     * @brief Bay that frees up first among those able to run the kind, or -1 if none can.
+     */
+    [[nodiscard]] int earliest(ServiceKind kind) const noexcept;
+
+    /**
+     * @brief Free-at minute of a bay as last reported through add() / update().
+     */
+    [[nodiscard]] int availAt(int bay) const noexcept { return avail_[static_cast<size_t>(bay)]; }
+
+    [[nodiscard]] int size() const noexcept { return static_cast<int>(avail_.size()); }
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "CarWashExceptions.h"
+
+/**
+ * @brief Append-only little-endian encoder for save files.
+ *
+ * Values are copied byte for byte (the game only targets little-endian hosts); strings are
+ * written as a 32-bit length followed by the raw bytes.
+ */
+class BinaryWriter {
+    std::string buf_;
+
+public:
+    template<typename T>
+    void pod(const T &v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto *p = reinterpret_cast<const char *>(&v);
+        buf_.append(p, sizeof(T));
+    }
+
+    void u8(std::uint8_t v) { pod(v); }
+    void u32(std::uint32_t v) { pod(v); }
+    void i32(std::int32_t v) { pod(v); }
+    void u64(std::uint64_t v) { pod(v); }
+    void f64(double v) { pod(v); }
+    void boolean(bool v) { u8(v ? 1 : 0); }
+
+    void str(const std::string &s) {
+        u32(static_cast<std::uint32_t>(s.size()));
+        buf_.append(s);
+    }
+
+    [[nodiscard]] const std::string &data() const noexcept { return buf_; }
+
+    /**
+     * @brief FNV-1a 64-bit hash of the bytes written so far.
+     */
+    [[nodiscard]] std::uint64_t digest() const noexcept {
+        std::uint64_t h = 0xCBF29CE484222325ULL;
+        for (unsigned char c: buf_) {
+            h ^= c;
+            h *= 0x100000001B3ULL;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Writes the buffer to path through a temporary file and a rename.
+     *
+     * A crash while saving never leaves a truncated file behind.
+     *
+     * @throws SaveFileException If the file cannot be written.
+     */
+    void writeFile(const std::string &path) const;
+};
+
+/**
+ * @brief Bounds-checked decoder matching BinaryWriter.
+ */
+class BinaryReader {
+    std::string buf_;
+    size_t pos_{0};
+
+    void need(size_t n) const {
+        if (buf_.size() - pos_ < n) throw SaveFileException("Fisier de salvare trunchiat");
+    }
+
+public:
+    explicit BinaryReader(std::string data) : buf_(std::move(data)) {
+    }
+
+    /**
+     * @throws SaveFileException If the file cannot be read.
+     */
+    static BinaryReader fromFile(const std::string &path);
+
+    template<typename T>
+    T pod() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        need(sizeof(T));
+        T v;
+        std::memcpy(&v, buf_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return v;
+    }
+
+    std::uint8_t u8() { return pod<std::uint8_t>(); }
+    std::uint32_t u32() { return pod<std::uint32_t>(); }
+    std::int32_t i32() { return pod<std::int32_t>(); }
+    std::uint64_t u64() { return pod<std::uint64_t>(); }
+    double f64() { return pod<double>(); }
+    bool boolean() { return u8() != 0; }
+
+    std::string str() {
+        const std::uint32_t n = u32();
+        need(n);
+        std::string s(buf_.data() + pos_, n);
+        pos_ += n;
+        return s;
+    }
+
+    /**
+     * @brief Reads an element count and rejects counts larger than the remaining bytes.
+     */
+    size_t count(size_t minBytesPerItem = 1) {
+        const std::uint32_t n = u32();
+        if (minBytesPerItem > 0 && n > (buf_.size() - pos_) / minBytesPerItem) {
+            throw SaveFileException("Fisier de salvare corupt");
+        }
+        return n;
+    }
+
+    [[nodiscard]] bool atEnd() const noexcept { return pos_ == buf_.size(); }
+
+    [[nodiscard]] size_t position() const noexcept { return pos_; }
+
+    [[nodiscard]] size_t size() const noexcept { return buf_.size(); }
+};
@@ -1,30 +1,96 @@
 #pragma once
 
-#include <deque>
+#include <cstdint>
 #include <memory>
 #include <iosfwd>
+#include <variant>
+#include <vector>
 
 #include "Customer.h"
+#include "Rng.h"
 
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @brief FIFO of waiting customers stored as a structure of arrays.
+ *
+ * Every waiting customer is kept as a packed record (id, arrival minute, budget,
+ * impatience, type tag: 15 bytes) spread over parallel ring buffers, so enqueueing
+ * never allocates once the buffers have grown and scanning the queue stays in cache.
+ * Only the head is materialized as a real Customer object, in place and without heap
+ * allocation, so the polymorphic chooseService / onServed logic keeps working unchanged.
+ */
 class CarQueue {
-    std::deque<std::unique_ptr<Customer> > q_;
+public:
+    /**
+     * @brief Unpacked view of one waiting customer.
+     */
+    struct Record {
+        std::uint32_t id{0};
+        std::int32_t arrivalMin{0};
+        float budget{0.0F};
+        std::uint16_t impatienceCenti{0}; /**< Impatience in hundredths (0.5 -> 50). */
+        CustomerType type{CustomerType::Rushed};
+    };
+
+private:
+    std::vector<std::uint32_t> ids_;
+    std::vector<std::int32_t> arrivals_;
+    std::vector<float> budgets_;
+    std::vector<std::uint16_t> impatience_;
+    std::vector<CustomerType> types_;
+    size_t head_{0};
+    size_t count_{0};
+
+    std::variant<std::monostate, RushedCustomer, BudgetCustomer, PremiumCustomer, EcoCustomer> front_;
+
     int nextId_{1};
     int demandPerHour_{2};
     int lost_{0};
 
+    size_t capacity() const noexcept { return ids_.size(); }
+    size_t slot(size_t i) const noexcept { return (head_ + i) & (capacity() - 1); }
+
+    void grow();
+
+    void push(const Record &r);
+
+    void refreshFront();
+
 public:
     CarQueue() = default;
 
+    void generateRandomCustomer(int arrivalMin, Rng &rng);
 
-    void generateRandomCustomers();
-
-    bool empty() const { return q_.empty(); }
-    int size() const { return static_cast<int>(q_.size()); }
+    bool empty() const { return count_ == 0; }
+    int size() const { return static_cast<int>(count_); }
     int lostCustomers() const { return lost_; }
     int demand() const { return demandPerHour_; }
 
+    /**
+     * @brief Customer at the head of the queue (materialized in place). Must not be empty().
+     */
+    const Customer &front() const;
+
+    Customer &front();
+
+    int frontArrival() const { return arrivals_[head_]; }
+
+    Record frontRecord() const;
+
+    /**
+     * @brief Removes the head and returns it as a heap-allocated Customer (nullptr if empty).
+     */
     std::unique_ptr<Customer> pop();
 
+    /**
+     * @brief Removes the head without building a Customer for it.
+     */
+    void drop();
+
+    static std::unique_ptr<Customer> makeCustomer(const Record &r);
+
     void failOne();
 
     void increaseDemand();
@@ -33,5 +99,9 @@ public:
 
     void print(std::ostream &os) const;
 
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+
     friend std::ostream &operator<<(std::ostream &, const CarQueue &);
 };
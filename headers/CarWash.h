@@ -3,8 +3,10 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 #include "../headers//Inventory.h"
 #include "WashBay.h"
@@ -18,8 +20,21 @@
 #include "ReputationManager.h"
 #include "PricingStrategy.h"
 #include "DailyReport.h"
+#include "ReportHistory.h"
 #include "AchievementManager.h"
 #include "Statistics.h"
+#include "SimEventQueue.h"
+#include "Rng.h"
+#include "ServiceChoiceIndex.h"
+#include "BayAvailabilityIndex.h"
+#include "BinaryIO.h"
+#include "WhatIf.h"
+#include "EventJournal.h"
+
+class ReplayRecorder;
+class ReplaySandbox;
+class ReportExporter;
+class HistoryLog;
 
 /**
  * @brief Core simulation engine for the CarWash Tycoon application.
@@ -39,8 +54,8 @@
 class CarWash {
     std::string name_;
     Inventory inv_;
-    std::vector<std::unique_ptr<WashService> > services_;
-    std::vector<std::unique_ptr<WashBay> > bays_;
+    std::vector<std::shared_ptr<WashService> > services_; /**< Shared between forks, copied on first write. */
+    std::vector<WashBay> bays_;
 
     double cash_{0.0};
     int openMin_;
@@ -51,10 +66,11 @@ class CarWash {
     CarQueue queue_;
     DemandManager demand_;
     GoalManager goals_;
-    std::vector<std::unique_ptr<Upgrade> > purchased_;
+    std::vector<std::shared_ptr<const Upgrade> > purchased_;
     EventManager events_;
     ReputationManager reputation_;
-    std::unique_ptr<PricingStrategy> pricing_;
+    ReputationBatch hourReputation_; /**< Outcomes of the hour being run, applied by applyReputation(). */
+    std::shared_ptr<PricingStrategy> pricing_; /**< Stateless, shared between forks. */
     AchievementManager achievements_;
 
     int totalCarsServed_{0};
@@ -68,19 +84,83 @@ class CarWash {
     double dailyRevenue_{0.0};
 
     DailyReport currentReport_;
-    std::vector<DailyReport> reports_;
+    std::shared_ptr<ReportHistory> reports_{std::make_shared<ReportHistory>()}; /**< Copy-on-write between forks. */
+    StatsAggregator stats_; /**< Running totals of reports_, updated at every day end. */
+    StreamingStats streaming_; /**< Moving windows and quantiles, fed per customer and per day. */
 
     double speedFactor_{1.0};
     double comfortBonus_{0.0};
     int baseDemandBonus_{0};
+    int sharedDemandBonus_{0};
 
     int totalSuppliesPacksBought_{0};
     int upgradesBought_{0};
 
     bool nanoCoatingEnabled_{false};
 
+    SimEventQueue sim_;
+    std::vector<WashService *> servicePtrs_;
+    std::unordered_map<std::string, int> serviceIds_; /**< Lowercased name -> index in services_ (first match). */
+    std::shared_ptr<const ServiceKeys> serviceKeys_{std::make_shared<ServiceKeys>()}; /**< Report keys of the catalog names. */
+    std::vector<ServiceKey> saleKeys_; /**< Report key of each entry of services_. */
+    ServiceChoiceIndex choiceIndex_;
+    BayAvailabilityIndex bayIndex_;
+
+    std::ostream *out_{&std::cout};
+    ReplayRecorder *recorder_{nullptr}; /**< Optional log of the interactive commands (not owned). */
+    ReplaySandbox *sandbox_{nullptr}; /**< Replaces save files while a log is replayed (not owned). */
+    EventJournal *journal_{nullptr}; /**< Optional audit journal of gameplay outcomes (not owned). */
+    ReportExporter *exporter_{nullptr}; /**< Optional export of reports and customer outcomes (not owned). */
+    RngStreams rng_;
+
     static constexpr int MAX_SERV = 20;
-    static constexpr int MAX_BAYS = 20;
+    static constexpr int MAX_BAYS = 512;
+
+    static constexpr std::uint32_t SAVE_MAGIC = 0x56535743; /**< "CWSV" */
+    static constexpr std::uint32_t SAVE_VERSION = 5;
+
+    /**
+     * @brief Registers an owned service in the catalog and its lookup structures.
+     */
+    void attachService(std::shared_ptr<WashService> s);
+
+    /**
+     * @brief Registers a bay in bays_ and the availability index.
+     */
+    void attachBay(WashBay b);
+
+    /**
+     * @brief Writes the snapshot; with a log, the report history is only referenced.
+     */
+    void saveState(BinaryWriter &w, const HistoryLog *history) const;
+
+    /**
+     * @brief Service i, unshared from other forks before it is modified.
+     */
+    WashService &mutableService(size_t i);
+
+    /**
+     * @brief Report history, unshared from other forks before it is appended to.
+     */
+    ReportHistory &mutableReports() {
+        if (reports_.use_count() > 1) reports_ = std::make_shared<ReportHistory>(*reports_);
+        return *reports_;
+    }
+
+    /**
+     * @brief Member-wise copy used by fork(): catalog, upgrades, events and report history are shared.
+     */
+    CarWash(const CarWash &other) = default;
+
+    /**
+     * @brief Creates the pricing strategy for a mode key (unknown keys give "balanced").
+     */
+    static std::unique_ptr<PricingStrategy> makePricing(const std::string &mode);
+
+    /**
+     * @brief Returns the console stream, or a discarding stream when running headless.
+     */
+    [[nodiscard]] std::ostream &out() const;
 
     /**
      * @brief Case-insensitive string equality.
@@ -91,6 +171,11 @@ class CarWash {
      */
     [[nodiscard]] bool sameCaseInsensitive(const std::string &a, const std::string &b) const;
 
+    /**
+     * @brief Lowercases a service name for the serviceIds_ lookup.
+     */
+    [[nodiscard]] static std::string normalizedName(const std::string &name);
+
     /**
      * @brief Finds a service index by name (case-insensitive).
      *
@@ -104,20 +189,59 @@ class CarWash {
      *
      * Computes daily aggregates, triggers achievement/goal/event hooks,
      * stores the DailyReport, resets per-day counters, and resets time/bays.
+     * Invoked by the DayEnd simulation event.
      */
     void endCurrentDay();
 
     /**
-     * @brief Applies the current pricing strategy to the service catalog.
+     * @brief Schedules the Closing and DayEnd events of the current day.
+     *
+     * Clears any pending events and re-arms BayFinished for bays that are still busy.
      */
-    void applyPricingStrategy();
+    void scheduleDay();
 
     /**
-     * @brief Switches the active pricing strategy.
+     * @brief Serves waiting customers in FIFO order while a capable bay is free right now.
      *
-     * @param mode Strategy key (e.g., "aggressive", "balanced", "conservative").
+     * The head of the queue keeps waiting (and blocks the ones behind it) until a
+     * BayFinished event frees a bay that can run its chosen service.
      */
-    void setPricingMode(const std::string &mode);
+    void dispatchWaiting();
+
+    /**
+     * @brief Books a service on a bay starting no earlier than the current minute.
+     *
+     * Collects the price and schedules the matching BayFinished event.
+     *
+     * @param bi Index in bays_.
+     * @param sp Service to run.
+     */
+    void startOnBay(size_t bi, const WashService &sp);
+
+    /**
+     * @brief Records a lost customer in the queue, reputation, achievements, demand and journal.
+     *
+     * @param who The customer that left (already removed from the queue).
+     * @param reason Why it left.
+     */
+    void loseCustomer(const CarQueue::Record &who, LossReason reason);
+
+    /**
+     * @brief Applies the outcomes collected since the last call to the reputation in one step.
+     *
+     * Called when runUntil returns (the end of an hour for simulateHour) and at day end.
+     */
+    void applyReputation();
+
+    /**
+     * @brief Journals a supply purchase.
+     */
+    void journalPurchase(SupplyItem item, int packs, double cost);
+
+    /**
+     * @brief Applies the current pricing strategy to the service catalog.
+     */
+    void applyPricingStrategy();
 
     /**
      * @brief Applies Nano Coating to all WaxService instances using RTTI.
@@ -140,6 +264,89 @@ public:
      */
     CarWash(std::string n, Inventory inv, int openM, int closeM);
 
+    CarWash(CarWash &&) = default;
+
+    CarWash &operator=(CarWash &&) = default;
+
+    CarWash &operator=(const CarWash &) = delete;
+
+    /**
+     * @brief Parses and executes one interactive command line (the body of the run() loop).
+     *
+     * @return false if the line ends the session (endrun); true otherwise.
+     * @throws CarWashException If the command is invalid or rejected.
+     */
+    bool executeCommand(const std::string &line);
+
+    /**
+     * @brief Records every command typed in run() (pass nullptr to stop recording).
+     *
+     * @param recorder Recorder that outlives the session; not owned.
+     */
+    void setRecorder(ReplayRecorder *recorder) noexcept { recorder_ = recorder; }
+
+    /**
+     * @brief Sends save/load through a replay sandbox instead of the file system (nullptr: files).
+     *
+     * @param sandbox Sandbox that outlives the replay; not owned.
+     */
+    void setSandbox(ReplaySandbox *sandbox) noexcept { sandbox_ = sandbox; }
+
+    /**
+     * @brief Journals every gameplay outcome (pass nullptr to stop).
+     *
+     * @param journal Journal that outlives the simulation; not owned. Forks never write to it.
+     */
+    void setJournal(EventJournal *journal) noexcept { journal_ = journal; }
+
+    /**
+     * @brief Exports every finalized day and, if the exporter asks for them, customer outcomes.
+     *
+     * @param exporter Exporter that outlives the simulation; not owned. Forks never write to it.
+     */
+    void setExporter(ReportExporter *exporter) noexcept { exporter_ = exporter; }
+
+    /**
+     * @brief Stamps a record with the current day and minute and passes it to the journal and
+     * the exporter (no-op without either).
+     */
+    void journal(JournalRecord r);
+
+    /**
+     * @brief 64-bit hash of the saveState() snapshot; equal digests mean equal simulation states.
+     */
+    [[nodiscard]] std::uint64_t stateDigest() const;
+
+    /**
+     * @brief Cheap independent copy of the whole simulation (headless).
+     *
+     * Immutable or rarely written data is shared: the service catalog (each service is
+     * cloned only when a branch changes its price or coating), purchased upgrades, today's
+     * events, the pricing strategy and the report history (copied on the first new day).
+     * Small mutable state (bays, queue, inventory, RNG streams, goals, achievements) is copied.
+     * The fork continues with the same random streams, so branches see the same customers.
+     */
+    [[nodiscard]] std::unique_ptr<CarWash> fork() const;
+
+    /**
+     * @brief Forks one branch per option, applies its action and simulates the next days in parallel.
+     *
+     * This instance is not modified. Results are in option order and do not depend on threads.
+     *
+     * @param options Candidate actions.
+     * @param days Days simulated per branch (the current day counts as the first).
+     * @param threads Worker threads (<= 0 uses every core).
+     */
+    [[nodiscard]] std::vector<WhatIfBranch> whatIf(const std::vector<WhatIfOption> &options, int days,
+                                                   int threads = 0) const;
+
+    /**
+     * @brief Compares doing nothing, every upgrade and every other pricing mode over the next days.
+     *
+     * @param days Days simulated per branch.
+     */
+    void showWhatIf(int days) const;
+
     /**
      * @brief Returns average satisfaction sample for the current day.
      *
@@ -175,8 +382,9 @@ public:
     /**
      * @brief Attempts to book multiple cars for a given service.
      *
-     * Each car is scheduled on the first suitable bay that can execute the service,
-     * finishes before close time, and has sufficient inventory.
+     * Each car is scheduled on the capable bay that frees up earliest, as long as it
+     * finishes before close time and inventory is sufficient. Bookings never start
+     * before the current simulated minute.
      *
      * @param serviceName Service name.
      * @param cars Number of cars to book.
@@ -187,15 +395,137 @@ public:
      */
     int bookCars(const std::string &serviceName, int cars);
 
+    /**
+     * @brief Same as bookCars(const std::string &, int) for an already resolved service.
+     *
+     * @param serviceId Index of the service in the catalog (see serviceId()).
+     * @param cars Number of cars to book.
+     * @return Number of cars actually booked.
+     *
+     * @throws InvalidServiceException If serviceId is out of range.
+     * @throws BookingException If cars <= 0.
+     */
+    int bookCars(int serviceId, int cars);
+
+    /**
+     * @brief Resolves a service name (case-insensitive) to its catalog index.
+     *
+     * @return Index usable with bookCars(int, int), or -1 if unknown.
+     */
+    [[nodiscard]] int serviceId(const std::string &name) const { return findService(name); }
+
     /**
      * @brief Simulates one hour of gameplay.
      *
-     * Advances time, generates customers, attempts to serve them based on bay capacity,
-     * updates cash/satisfaction/reputation/achievements, adjusts demand, and ends the
-     * day when closing time is reached.
+     * Schedules the hour's customer arrivals, runs the event engine to the end of the
+     * hour (bays serve customers at their real finish times), then adjusts demand.
+     * The day ends through the DayEnd event when closing time is reached.
      */
     void simulateHour();
 
+    /**
+     * @brief Advances the discrete-event clock up to (and including) a given minute.
+     *
+     * Pops events in timestamp order and jumps the clock from one event to the next.
+     * Stops right after a DayEnd event, since the clock then restarts at opening time.
+     *
+     * @param minute Target minute since midnight of the current day.
+     */
+    void runUntil(int minute);
+
+    /**
+     * @brief Returns the current simulated minute since midnight.
+     */
+    [[nodiscard]] int currentMinute() const noexcept { return nowMin_; }
+
+    /**
+     * @brief Returns the current (not yet finalized) day index.
+     */
+    [[nodiscard]] int currentDay() const noexcept { return day_; }
+
+    /**
+     * @brief Simulates whole days hour by hour, without any dashboard output.
+     *
+     * @param days Number of days to complete; values <= 0 do nothing.
+     */
+    void runDays(int days);
+
+    /**
+     * @brief Redirects all console output of this instance.
+     *
+     * @param os Target stream, or nullptr for headless runs: hot-path messages are then
+     *           skipped before any formatting happens.
+     */
+    void setOutput(std::ostream *os) noexcept { out_ = os; }
+
+    /**
+     * @brief Seeds the random sub-streams (arrivals, customers, events).
+     *
+     * Every instance owns its generators, so independent instances can run on
+     * different threads. Unseeded instances start from std::random_device.
+     *
+     * @param seed Seed value; the same seed reproduces the same run.
+     */
+    void seed(std::uint64_t seed);
+
+    /**
+     * @brief Serializes the complete simulation state into a versioned binary snapshot.
+     *
+     * Covers catalog (including Wax nano coating state), bays, inventory, queue, pending
+     * simulation events, RNG streams, demand, reputation, goals, achievements, reports,
+     * streaming statistics, pricing mode, upgrades and today's events. The output stream is
+     * not part of the state.
+     */
+    void saveState(BinaryWriter &w) const { saveState(w, nullptr); }
+
+    /**
+     * @brief Rebuilds a simulation from a snapshot written by saveState() or checkpoint().
+     *
+     * The restored instance is headless; call setOutput() to attach a console.
+     *
+     * @param r Snapshot reader positioned at the magic number.
+     * @param dir Directory of the snapshot file, where a checkpoint's history log is looked up.
+     * @throws SaveFileException If the snapshot is truncated, corrupt or of another version.
+     */
+    static std::unique_ptr<CarWash> restoreState(BinaryReader &r, const std::string &dir = {});
+
+    /**
+     * @brief Writes a snapshot to a file (atomically replaced), or to the replay sandbox if set.
+     *
+     * @throws SaveFileException If the file cannot be written.
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * @brief Writes a snapshot whose report history lives in an append-only log.
+     *
+     * Only the days added since the previous checkpoint are appended to history; the snapshot
+     * itself stays small, so checkpointing every day costs O(1) per day. Read it back with
+     * load() while the log (kept next to the snapshot) exists.
+     *
+     * @param path Snapshot file (atomically replaced).
+     * @param history Log of this run, normally path + HistoryLog::SUFFIX.
+     * @throws SaveFileException If the log or the snapshot cannot be written.
+     */
+    void checkpoint(const std::string &path, HistoryLog &history) const;
+
+    /**
+     * @brief Replaces the whole state of this instance with a snapshot file.
+     *
+     * The current state is kept if the file cannot be loaded. The output stream is kept. While
+     * recording, the restored state is embedded in the log; while replaying, it comes from there.
+     *
+     * @throws SaveFileException If the file cannot be read or is invalid.
+     */
+    void load(const std::string &path);
+
+    /**
+     * @brief Prints the Statistics summary (no per-day series) for the stored reports.
+     *
+     * @param os Output stream.
+     */
+    void printSummary(std::ostream &os) const;
+
     /**
      * @brief Prints the current customer queue.
      */
@@ -263,6 +593,23 @@ public:
      */
     void showStats() const;
 
+    /**
+     * @brief Switches the active pricing strategy.
+     *
+     * @param mode Strategy key (e.g., "aggressive", "balanced", "conservative").
+     */
+    void setPricingMode(const std::string &mode);
+
+    /**
+     * @brief Builds analytics over the stored daily reports.
+     */
+    [[nodiscard]] Statistics statistics() const { return Statistics(reports_, stats_, streaming_); }
+
+    /**
+     * @brief Finalized daily reports, oldest first.
+     */
+    [[nodiscard]] const ReportHistory &reports() const noexcept { return *reports_; }
+
     /**
      * @brief Buys and applies an upgrade by id.
      *
@@ -310,6 +657,24 @@ public:
      */
     void increaseBaseDemand(int delta) { baseDemandBonus_ += delta; }
 
+    /**
+     * @brief Returns the demand bonus bought through marketing at this site.
+     */
+    [[nodiscard]] int marketingBonus() const noexcept { return baseDemandBonus_; }
+
+    /**
+     * @brief Sets the extra hourly demand coming from marketing at other sites of a chain.
+     */
+    void setSharedDemandBonus(int bonus) noexcept { sharedDemandBonus_ = bonus; }
+
+    /**
+     * @brief Blends the reputation score towards a chain-wide score.
+     *
+     * @param target Chain score (0..5).
+     * @param weight Share of the chain score in the result (0..1).
+     */
+    void blendReputation(double target, double weight) { reputation_.blendToward(target, weight); }
+
     /**
      * @brief Adjusts cash balance by a delta value.
      *
@@ -388,6 +753,8 @@ public:
     /**
      * @brief Logs a message to the output stream (console).
      *
+     * Does nothing (not even formatting) when the instance runs headless.
+     *
      * @param msg Message text.
      */
     void logEvent(const std::string &msg) const;
@@ -36,3 +36,31 @@ public:
         : CarWashException(msg) {
     }
 };
+
+class SaveFileException : public CarWashException {
+public:
+    explicit SaveFileException(const std::string &msg)
+        : CarWashException(msg) {
+    }
+};
+
+class JournalException : public CarWashException {
+public:
+    explicit JournalException(const std::string &msg)
+        : CarWashException(msg) {
+    }
+};
+
+class ExportException : public CarWashException {
+public:
+    explicit ExportException(const std::string &msg)
+        : CarWashException(msg) {
+    }
+};
+
+class CatalogException : public CarWashException {
+public:
+    explicit CatalogException(const std::string &msg)
+        : CarWashException(msg) {
+    }
+};
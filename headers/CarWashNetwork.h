@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include "ReportHistory.h"
+#include "Statistics.h"
+#include "ThreadPool.h"
+
+class CarWash;
+class Scenario;
+
+/**
+ * @brief A chain of car wash sites simulated side by side.
+ *
+ * Every site is an independent, headless CarWash with its own bays, inventory, queue and
+ * random streams. stepHour() advances all sites by one hour in parallel on a work-stealing
+ * ThreadPool; after the barrier the cross-site effects are applied on the calling thread:
+ * - shared marketing: each site gets part of the marketing bonus bought by the other sites
+ *   as extra hourly demand;
+ * - chain reputation: each site's score is blended towards the chain average.
+ *
+ * Once every site finished a day, the per-site DailyReports of that day are merged into
+ * one chain-level report. Sites never touch each other during a step, so results do not
+ * depend on the thread count.
+ */
+class CarWashNetwork {
+    std::vector<std::unique_ptr<CarWash> > sites_;
+    ThreadPool pool_;
+    std::shared_ptr<ReportHistory> chainReports_{std::make_shared<ReportHistory>()}; /**< Shared with Statistics views. */
+    StatsAggregator chainStats_;
+    StreamingStats chainStreaming_; /**< Daily figures only; per-customer data stays with the sites. */
+
+    double marketingSpill_{0.5};
+    double reputationBlend_{0.1};
+
+    /**
+     * @brief Simulates one hour on the given sites in parallel.
+     */
+    void stepSites(const std::vector<int> &ids);
+
+    /**
+     * @brief Applies shared marketing demand and chain reputation (barrier phase).
+     */
+    void applyChainEffects();
+
+    /**
+     * @brief Merges every day that all sites have finished into chainReports_.
+     */
+    void collectFinishedDays();
+
+public:
+    /**
+     * @brief Builds a chain of identical sites from one scenario.
+     *
+     * @param scenario Site template.
+     * @param sites Number of sites (> 0).
+     * @param baseSeed Seed from which every site's seed is derived.
+     * @param threads Threads used for stepping (<= 0 uses every core).
+     *
+     * @throws CarWashException If sites <= 0 or the scenario cannot be built.
+     */
+    CarWashNetwork(const Scenario &scenario, int sites, std::uint64_t baseSeed, int threads);
+
+    ~CarWashNetwork();
+
+    CarWashNetwork(const CarWashNetwork &) = delete;
+
+    CarWashNetwork &operator=(const CarWashNetwork &) = delete;
+
+    /**
+     * @brief Advances every site by one hour, then applies the cross-site effects.
+     */
+    void stepHour();
+
+    /**
+     * @brief Advances the chain until every site finished its current day.
+     */
+    void stepDay();
+
+    void runDays(int days);
+
+    /**
+     * @brief Share (0..1) of the other sites' average marketing bonus each site receives.
+     */
+    void setMarketingSpill(double spill) noexcept { marketingSpill_ = spill; }
+
+    /**
+     * @brief Weight (0..1) of the chain average in each site's reputation after a step.
+     */
+    void setReputationBlend(double weight) noexcept { reputationBlend_ = weight; }
+
+    [[nodiscard]] int siteCount() const noexcept { return static_cast<int>(sites_.size()); }
+    [[nodiscard]] const CarWash &site(int i) const { return *sites_.at(static_cast<size_t>(i)); }
+    [[nodiscard]] CarWash &site(int i) { return *sites_.at(static_cast<size_t>(i)); }
+
+    /**
+     * @brief Chain-level reports, one per fully finished day.
+     */
+    [[nodiscard]] const ReportHistory &reports() const noexcept { return *chainReports_; }
+
+    [[nodiscard]] Statistics statistics() const { return Statistics(chainReports_, chainStats_, chainStreaming_); }
+
+    [[nodiscard]] double totalCash() const noexcept;
+
+    [[nodiscard]] double averageReputation() const noexcept;
+
+    /**
+     * @brief Prints the chain summary and the best / worst site by cash.
+     */
+    void printSummary(std::ostream &os) const;
+};
@@ -4,9 +4,15 @@
 #include <vector>
 #include <iosfwd>
 #include <memory>
+#include <cstdint>
 
 class WashService;
 
+/**
+ * @brief Compact tag of the concrete Customer subclass (used by the packed queue storage).
+ */
+enum class CustomerType : std::uint8_t { Rushed, Budget, Premium, Eco };
+
 class Customer {
 protected:
     int id_;
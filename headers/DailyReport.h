@@ -1,39 +1,90 @@
 #pragma once
 
+#include <memory>
 #include <string>
-#include <map>
+#include <vector>
 #include <iosfwd>
 
+#include "ServiceKeys.h"
+
+class BinaryWriter;
+class BinaryReader;
+
 struct ServiceStats {
     int cars{0};
     double revenue{0.0};
 };
 
+/**
+ * @brief Figures of one day; per-service figures are a flat array indexed by ServiceKey.
+ *
+ * Recording a sale is an array increment. The key table is shared (never copied) and only
+ * needed to turn keys back into names for printing, merging and saving.
+ */
 class DailyReport {
     int day_{0};
     int totalCars_{0};
     int lostCustomers_{0};
     double totalRevenue_{0.0};
     double avgSatisfaction_{0.0};
-    std::map<std::string, ServiceStats> perService_;
+    std::vector<ServiceStats> perService_;
+    std::shared_ptr<const ServiceKeys> keys_{std::make_shared<ServiceKeys>()};
 
 public:
     DailyReport() = default;
 
     void beginDay(int day);
 
-    void addServiceSale(const std::string &name, double price);
+    /**
+     * @brief Sets the key table; it must contain every key recorded so far (tables only grow).
+     */
+    void setKeys(std::shared_ptr<const ServiceKeys> keys) { keys_ = std::move(keys); }
+
+    void addServiceSale(ServiceKey key, double price) {
+        if (key >= perService_.size()) perService_.resize(static_cast<size_t>(key) + 1);
+        ServiceStats &st = perService_[key];
+        st.cars += 1;
+        st.revenue += price;
+    }
+
+    /**
+     * @brief Adds to the figures of one service (used when rebuilding a report from a history).
+     */
+    void addServiceStats(ServiceKey key, const ServiceStats &st);
 
     void finalize(int totalCars, int lost, double avgSat, double totalRevenue);
 
+    /**
+     * @brief Adds another finalized report of the same day (e.g. another site of a chain).
+     *
+     * Totals are summed and the satisfaction average is weighted by cars. Services are
+     * matched by name, so the two reports may use different key tables.
+     */
+    void merge(const DailyReport &other);
+
     int day() const noexcept { return day_; }
     int totalCars() const noexcept { return totalCars_; }
     int lostCustomers() const noexcept { return lostCustomers_; }
     double totalRevenue() const noexcept { return totalRevenue_; }
     double avgSatisfaction() const noexcept { return avgSatisfaction_; }
-    const std::map<std::string, ServiceStats> &perService() const noexcept { return perService_; }
+
+    /**
+     * @brief Per-service figures indexed by key (may be shorter than keys().size()).
+     */
+    const std::vector<ServiceStats> &perService() const noexcept { return perService_; }
+
+    const ServiceKeys &keys() const noexcept { return *keys_; }
+
+    const std::shared_ptr<const ServiceKeys> &sharedKeys() const noexcept { return keys_; }
 
     void print(std::ostream &os) const;
+
+    void save(BinaryWriter &w) const;
+
+    /**
+     * @brief Reads a report written by save(); service names must exist in the current key table.
+     */
+    void load(BinaryReader &r);
 };
 
 std::ostream &operator<<(std::ostream &os, const DailyReport &rep);
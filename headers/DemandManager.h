@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MathUtils.h"
+#include "BinaryIO.h"
 
 class DemandManager {
     int score_{0}; // poate fi negativ
@@ -17,4 +18,7 @@ public:
     }
 
     void reset() { score_ = 0; }
+
+    void save(BinaryWriter &w) const { w.i32(score_); }
+    void load(BinaryReader &r) { score_ = r.i32(); }
 };
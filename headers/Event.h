@@ -30,6 +30,8 @@ class WeatherEvent : public Event {
 public:
     explicit WeatherEvent(double intensity);
 
+    double intensity() const noexcept { return intensity_; }
+
     void apply(CarWash &wash) override;
 
     void print(std::ostream &os) const override;
@@ -49,6 +51,8 @@ class InspectionEvent : public Event {
 public:
     explicit InspectionEvent(double severity);
 
+    double severity() const noexcept { return severity_; }
+
     void apply(CarWash &wash) override;
 
     void print(std::ostream &os) const override;
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Kind of a journal record.
+ */
+enum class JournalType : std::uint8_t {
+    Served = 1, /**< subject = customer type, ref = customer id, extra = wait (min), value = satisfaction, aux = service kind, amount = price. */
+    Lost = 2, /**< subject = customer type, ref = customer id, extra = LossReason. */
+    DayEnd = 3, /**< ref = cars served, extra = lost, value = average satisfaction, amount = revenue. */
+    BuySupplies = 4, /**< subject = SupplyItem, ref = packs, amount = cost. */
+    BuyUpgrade = 5, /**< subject = upgrade id, amount = cost. */
+    EventApplied = 6 /**< subject = event kind (0 weather, 1 holiday, 2 inspection), value = intensity / severity. */
+};
+
+/**
+ * @brief Why a customer left without being served.
+ */
+enum class LossReason : std::uint8_t { NoAffordableService, NoCapableBay, OutOfStock, Closing };
+
+/**
+ * @brief Supply item codes used by BuySupplies records.
+ */
+enum class SupplyItem : std::uint8_t { Water, Shampoo, Wax };
+
+/**
+ * @brief One fixed-size (32 byte) journal record; the meaning of the fields depends on type.
+ */
+struct JournalRecord {
+    std::uint32_t day{0};
+    std::uint16_t minute{0};
+    JournalType type{JournalType::Served};
+    std::uint8_t subject{0};
+    std::uint32_t ref{0};
+    std::uint32_t extra{0};
+    float value{0.0F};
+    std::uint32_t aux{0};
+    double amount{0.0};
+};
+
+static_assert(sizeof(JournalRecord) == 32, "journal records must stay 32 bytes");
+
+/**
+ * @brief Append-only journal of gameplay outcomes in memory-mapped, size-rotated files.
+ *
+ * Segments are named "<base>.<n>.jrn" (n = 000000, 000001, ...). Each one starts with a
+ * 32-byte header (magic "CWJR", version, record size, segment index) followed by records.
+ * A segment is created at full size and mapped, so append() is a bounds check and a 32-byte
+ * store; when it is full the segment is trimmed to the records written and the next one
+ * is opened. If the process dies, the unwritten tail of the last segment stays zero, and
+ * readers stop at the first record with type 0.
+ *
+ * On platforms without mmap the segment lives in a heap buffer written out on rotation
+ * and close; the file format is the same.
+ */
+class EventJournal {
+    std::string base_;
+    std::size_t capacity_; /**< Records per segment. */
+    std::uint32_t segment_{0};
+    JournalRecord *records_{nullptr};
+    JournalRecord *next_{nullptr};
+    JournalRecord *end_{nullptr};
+    void *map_{nullptr};
+    std::size_t mapBytes_{0};
+#if !defined(_WIN32)
+    int fd_{-1};
+#endif
+    std::uint64_t total_{0};
+
+    [[nodiscard]] std::string segmentPath(std::uint32_t index) const;
+
+    void openSegment();
+
+    void closeSegment();
+
+public:
+    static constexpr std::uint32_t MAGIC = 0x524A5743; /**< "CWJR" */
+    static constexpr std::uint16_t VERSION = 1;
+
+    /**
+     * @param base Path prefix of the segment files.
+     * @param segmentBytes Maximum size of one segment file (at least one record is kept).
+     * @throws JournalException If the first segment cannot be created.
+     */
+    EventJournal(std::string base, std::size_t segmentBytes);
+
+    ~EventJournal();
+
+    EventJournal(const EventJournal &) = delete;
+
+    EventJournal &operator=(const EventJournal &) = delete;
+
+    /**
+     * @brief Appends one record, rotating to a new segment when the current one is full.
+     */
+    void append(const JournalRecord &r) {
+        if (next_ == end_) {
+            closeSegment();
+            ++segment_;
+            openSegment();
+        }
+        *next_++ = r;
+        ++total_;
+    }
+
+    [[nodiscard]] std::uint64_t recordsWritten() const noexcept { return total_; }
+
+    /**
+     * @brief Number of segment files created so far.
+     */
+    [[nodiscard]] std::uint32_t segments() const noexcept { return segment_ + 1; }
+};
@@ -5,23 +5,33 @@
 #include <iosfwd>
 
 #include "Event.h"
+#include "Rng.h"
 
 class CarWash;
+class BinaryWriter;
+class BinaryReader;
 
 class EventManager {
-    std::vector<std::unique_ptr<Event> > todays_;
+    // evenimentele nu se modifica dupa generare, deci copiile (fork) le pot partaja
+    std::vector<std::shared_ptr<Event> > todays_;
 
 public:
     EventManager() = default;
 
     void clear();
 
-    void generateForNewDay(const CarWash &wash);
+    // rng: sub-stream-ul de evenimente al instantei CarWash (fara stare globala)
+    void generateForNewDay(const CarWash &wash, Rng &rng);
 
     void applyAll(CarWash &wash);
 
     // helper: apelat la sfarsitul fiecarui endCurrentDay
-    void startNewDay(CarWash &wash);
+    void startNewDay(CarWash &wash, Rng &rng);
 
     void print(std::ostream &os) const;
+
+    // salveaza evenimentele zilei curente (deja aplicate, nu se reaplica la incarcare)
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
 };
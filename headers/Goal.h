@@ -1,10 +1,18 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <iosfwd>
 
 class CarWash;
 
+// marimea din joc urmarita de un obiectiv (GoalManager reverifica doar obiectivele
+// a caror marime s-a schimbat)
+enum class GoalMetric { Cash, CarsServed, Satisfaction };
+
+inline constexpr std::size_t GOAL_METRICS = 3;
+
 class Goal {
 protected:
     std::string description_;
@@ -30,8 +38,20 @@ public:
     // verifica si actualizeaza progresul + achieved_
     virtual bool check(const CarWash &wash) = 0;
 
+    // marimea de care depinde check()
+    virtual GoalMetric metric() const noexcept = 0;
+
+    // copie independenta (folosita la fork-ul simularii)
+    virtual std::unique_ptr<Goal> clone() const = 0;
+
     // acces la progres (NU mai depinde de CarWash)
     double progress() const noexcept { return lastProgress_; }
+
+    // folosit la incarcarea unei salvari
+    void restore(bool achieved, double progress) {
+        achieved_ = achieved;
+        setProgressInternal(progress);
+    }
 };
 
 class ProfitGoal : public Goal {
@@ -43,6 +63,10 @@ public:
     }
 
     bool check(const CarWash &wash) override;
+
+    GoalMetric metric() const noexcept override { return GoalMetric::Cash; }
+
+    std::unique_ptr<Goal> clone() const override { return std::make_unique<ProfitGoal>(*this); }
 };
 
 class CarsServedGoal : public Goal {
@@ -54,6 +78,10 @@ public:
     }
 
     bool check(const CarWash &wash) override;
+
+    GoalMetric metric() const noexcept override { return GoalMetric::CarsServed; }
+
+    std::unique_ptr<Goal> clone() const override { return std::make_unique<CarsServedGoal>(*this); }
 };
 
 class RatingGoal : public Goal {
@@ -65,4 +93,8 @@ public:
     }
 
     bool check(const CarWash &wash) override;
+
+    GoalMetric metric() const noexcept override { return GoalMetric::Satisfaction; }
+
+    std::unique_ptr<Goal> clone() const override { return std::make_unique<RatingGoal>(*this); }
 };
@@ -1,30 +1,66 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <memory>
+#include <optional>
 #include <iosfwd>
 
 #include "Goal.h"
 
 class CarWash;
+class BinaryWriter;
+class BinaryReader;
 
+/**
+ * @brief Campaign goals of a game, with their completion count kept up to date.
+ *
+ * Goals are indexed by the metric they watch; checkAll() reads every metric once and only
+ * re-checks the goals whose metric changed since the previous check, and the achieved
+ * count is adjusted whenever a check changes a goal's state, so allAchieved() and
+ * completionRatio() are O(1).
+ */
 class GoalManager {
     std::vector<std::unique_ptr<Goal> > goals_;
+    std::array<std::vector<size_t>, GOAL_METRICS> byMetric_{}; // indici in goals_
+    std::array<std::optional<double>, GOAL_METRICS> lastValue_{}; // valoarea la ultima verificare
+    int total_{0};
+    int achieved_{0};
+
+    static double metricValue(const CarWash &wash, GoalMetric m);
+
+    void recount();
 
 public:
     GoalManager() = default;
 
-    void add(std::unique_ptr<Goal> g) {
-        goals_.push_back(std::move(g));
-    }
+    // cloneaza fiecare obiectiv (starea lor difera intre ramuri)
+    GoalManager(const GoalManager &other);
 
-    void checkAll(const CarWash &wash);
+    GoalManager &operator=(const GoalManager &) = delete;
+
+    GoalManager(GoalManager &&) = default;
 
-    bool allAchieved() const;
+    GoalManager &operator=(GoalManager &&) = default;
 
+    void add(std::unique_ptr<Goal> g);
 
-    double completionRatio() const;
+    /**
+     * @brief Re-checks the goals whose metric changed since the last call.
+     */
+    void checkAll(const CarWash &wash);
+
+    bool allAchieved() const noexcept { return total_ > 0 && achieved_ == total_; }
+
+    double completionRatio() const noexcept {
+        return total_ > 0 ? static_cast<double>(achieved_) / static_cast<double>(total_) : 0.0;
+    }
 
 
     void print(std::ostream &os, const CarWash &wash) const;
+
+    // salveaza doar starea (obiectivele sunt definite de constructorul CarWash)
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
 };
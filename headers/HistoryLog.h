@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+class ReportHistory;
+
+/**
+ * @brief Append-only side file holding the report history of a checkpointed run.
+ *
+ * Daily checkpoints would otherwise rewrite every stored day each time, which makes
+ * checkpointing every day O(days^2) over a long batch. With a log, a checkpoint appends
+ * only the rows added since the previous one and the atomically replaced snapshot
+ * records how many rows (and bytes) of the log belong to it; rows appended after the
+ * last snapshot are ignored on load.
+ *
+ * The file starts with a magic number and a random id that the snapshot repeats, so a
+ * snapshot never reads rows from a log another run has recreated. A new log always
+ * starts empty: the first append of a resumed run rewrites the rows loaded with it.
+ */
+class HistoryLog {
+    std::string path_;
+    std::ofstream out_;
+    std::uint64_t id_{0};
+    std::uint64_t rows_{0};
+    std::uint64_t bytes_{0};
+
+public:
+    static constexpr std::uint32_t MAGIC = 0x48535743; /**< "CWSH" */
+    static constexpr const char *SUFFIX = ".hist";
+
+    /**
+     * @brief Creates (or truncates) the log file.
+     *
+     * @throws SaveFileException If the file cannot be created.
+     */
+    explicit HistoryLog(std::string path);
+
+    HistoryLog(const HistoryLog &) = delete;
+
+    HistoryLog &operator=(const HistoryLog &) = delete;
+
+    /**
+     * @brief Appends the days of history not yet in the log and flushes them.
+     *
+     * @throws SaveFileException If the rows cannot be written.
+     */
+    void append(const ReportHistory &history);
+
+    [[nodiscard]] const std::string &path() const noexcept { return path_; }
+    [[nodiscard]] std::uint64_t id() const noexcept { return id_; }
+    [[nodiscard]] std::uint64_t rows() const noexcept { return rows_; }
+    [[nodiscard]] std::uint64_t bytes() const noexcept { return bytes_; }
+
+    /**
+     * @brief Reads the first rows of a log into history, whose layout is already restored.
+     *
+     * @param path Log file.
+     * @param id Id recorded by the snapshot.
+     * @param rows Rows recorded by the snapshot.
+     * @param bytes Log length recorded by the snapshot.
+     * @param history Target (see ReportHistory::loadLayout()).
+     * @throws SaveFileException If the log is missing, shorter or belongs to another run.
+     */
+    static void read(const std::string &path, std::uint64_t id, std::uint64_t rows, std::uint64_t bytes,
+                     ReportHistory &history);
+};
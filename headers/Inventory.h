@@ -3,6 +3,9 @@
 #include <iosfwd>
 #include "WashService.h"
 
+class BinaryWriter;
+class BinaryReader;
+
 class Inventory {
     int water_{0};
     int shampoo_{0};
@@ -22,5 +25,9 @@ public:
 
     bool takeIfCan(const WashService &sp, int cars);
 
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+
     friend std::ostream &operator<<(std::ostream &os, const Inventory &inv);
 };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+class Scenario;
+class ThreadPool;
+
+/**
+ * @brief Outcome of one simulated replica (one seed).
+ */
+struct ReplicaResult {
+    std::uint64_t seed{0};
+    int cars{0};
+    double revenue{0.0};
+    int lost{0};
+    double satisfaction{0.0}; /**< Car-weighted average satisfaction over the run. */
+    double finalCash{0.0};
+};
+
+/**
+ * @brief Distribution summary of one metric across replicas.
+ */
+struct MetricBand {
+    double mean{0.0};
+    double variance{0.0}; /**< Sample variance (n - 1). */
+    double min{0.0};
+    double p10{0.0};
+    double p50{0.0};
+    double p90{0.0};
+    double max{0.0};
+};
+
+/**
+ * @brief Merged Monte Carlo results.
+ */
+struct MonteCarloSummary {
+    int replicas{0};
+    int days{0};
+    MetricBand revenue;
+    MetricBand lost;
+    MetricBand satisfaction;
+    MetricBand finalCash;
+};
+
+/**
+ * @brief Runs many independent replicas of a scenario and merges their statistics.
+ *
+ * Replica i is built from the scenario, seeded with seedFor(baseSeed, i) and simulated
+ * headless for the requested number of days. Replicas run on a ThreadPool; each result is
+ * stored at its own index and merged in index order, so the summary is bit-identical for
+ * any thread count.
+ */
+class MonteCarloRunner {
+    const Scenario &scenario_;
+    int days_;
+    std::uint64_t baseSeed_;
+
+public:
+    /**
+     * @param scenario Scenario to replicate (must outlive the runner).
+     * @param days Days simulated per replica.
+     * @param baseSeed Seed from which all replica seeds are derived.
+     */
+    MonteCarloRunner(const Scenario &scenario, int days, std::uint64_t baseSeed);
+
+    /**
+     * @brief Derives the seed of replica i.
+     */
+    static std::uint64_t seedFor(std::uint64_t baseSeed, int replica) noexcept;
+
+    /**
+     * @brief Simulates all replicas.
+     *
+     * @param replicas Number of replicas.
+     * @param threads Worker threads (<= 0 uses every core).
+     * @return Results ordered by replica index.
+     */
+    std::vector<ReplicaResult> run(int replicas, int threads) const;
+
+    /**
+     * @brief Simulates all replicas on an existing pool.
+     */
+    std::vector<ReplicaResult> run(int replicas, ThreadPool &pool) const;
+
+    /**
+     * @brief Merges replica results into mean/variance/percentile bands.
+     *
+     * @param pool Optional pool for the block-parallel reductions; the bands do not depend on it.
+     */
+    static MonteCarloSummary summarize(const std::vector<ReplicaResult> &results, int days,
+                                       ThreadPool *pool = nullptr);
+
+    static void print(std::ostream &os, const MonteCarloSummary &s);
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <ostream>
+#include <streambuf>
+
+/**
+ * @brief Stream buffer that accepts and discards every character.
+ */
+class NullBuffer final : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+/**
+ * @brief Output stream that discards everything written to it (headless runs).
+ */
+class NullStream final : public std::ostream {
+    NullBuffer buf_;
+
+public:
+    NullStream() : std::ostream(&buf_) {
+    }
+};
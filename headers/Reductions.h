@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class ThreadPool;
+
+/**
+ * @brief Instruction set used by the reduction kernels.
+ */
+enum class SimdLevel : std::uint8_t { Scalar, Avx2 };
+
+/**
+ * @brief Smallest and largest value of a column and the first index of each.
+ */
+template<typename T>
+struct ColumnExtremes {
+    T min{};
+    T max{};
+    size_t argMin{0};
+    size_t argMax{0};
+};
+
+/**
+ * @brief Reduction kernels over contiguous metric columns.
+ *
+ * Every kernel has a scalar reference version and, on x86-64 with GCC or Clang, an AVX2
+ * version; the best level the CPU supports is picked on first use and only kept if it
+ * agrees with the scalar kernels on a probe column (selfCheck), otherwise the scalar
+ * kernels are used. Floating-point sums are reassociated across SIMD lanes, so they can
+ * differ from a sequential loop in the last bits; integer sums and extremes are exact.
+ *
+ * Columns longer than PARALLEL_BLOCK are cut into fixed blocks combined in block order;
+ * with a pool the blocks are reduced in parallel. The result is the same with or without a
+ * pool and for any thread count.
+ */
+class Reductions {
+public:
+    static constexpr size_t PARALLEL_BLOCK = size_t{1} << 16;
+
+    /**
+     * @brief Level the kernels dispatch to.
+     */
+    static SimdLevel level() noexcept;
+
+    /**
+     * @brief Best level this CPU supports (before the self-check).
+     */
+    static SimdLevel supportedLevel() noexcept;
+
+    /**
+     * @brief Forces a level (e.g. Scalar for comparisons); unsupported or failing levels fall back to Scalar.
+     */
+    static void setLevel(SimdLevel level) noexcept;
+
+    static const char *levelName(SimdLevel level) noexcept;
+
+    /**
+     * @brief Runs the kernels of a level on probe data and compares them with the scalar ones.
+     */
+    static bool selfCheck(SimdLevel level) noexcept;
+
+    static double sum(std::span<const double> v, ThreadPool *pool = nullptr);
+
+    static std::int64_t sum(std::span<const std::int32_t> v, ThreadPool *pool = nullptr);
+
+    /**
+     * @brief Kahan-compensated sum (error independent of the column length).
+     */
+    static double kahanSum(std::span<const double> v, ThreadPool *pool = nullptr);
+
+    /**
+     * @brief Sum of (v[i] - center)^2, the numerator of a two-pass variance.
+     */
+    static double sumSquaredDeviations(std::span<const double> v, double center, ThreadPool *pool = nullptr);
+
+    /**
+     * @brief Sum of v[i] * w[i] / sum of w[i] (0 if the weights sum to 0). Spans must have equal length.
+     */
+    static double weightedMean(std::span<const double> v, std::span<const std::int32_t> w, ThreadPool *pool = nullptr);
+
+    /**
+     * @brief Min / max with their first indices; an empty column gives all zeros.
+     */
+    static ColumnExtremes<double> extremes(std::span<const double> v, ThreadPool *pool = nullptr);
+
+    static ColumnExtremes<std::int32_t> extremes(std::span<const std::int32_t> v, ThreadPool *pool = nullptr);
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "BinaryIO.h"
+
+class CarWash;
+
+/**
+ * @brief Writes an interactive session as a compact binary command log.
+ *
+ * Layout: magic "CWRL", version, seed, the initial CarWash snapshot (saveState), then one
+ * record per command (tag 1, day, minute, text), after a successful load command the state
+ * it loaded (tag 3, snapshot), and a closing record (tag 2, digest of the final state). The
+ * simulation is deterministic given snapshot + commands + loaded states, so this is enough
+ * to reproduce the session exactly without the save files it touched. Records are appended
+ * and flushed one by one, so a crash keeps everything typed so far (without the closing
+ * digest).
+ */
+class ReplayRecorder {
+    std::string path_;
+    std::ofstream out_;
+    bool finished_{false};
+
+    void append(const BinaryWriter &w);
+
+public:
+    /**
+     * @param path Log file.
+     * @param seed Seed the session was started with (informative; the snapshot holds the RNG state).
+     * @param initial State before the first command.
+     * @throws SaveFileException If the file cannot be written.
+     */
+    ReplayRecorder(std::string path, std::uint64_t seed, const CarWash &initial);
+
+    /**
+     * @brief Appends one command with the simulated day and minute at which it was issued.
+     */
+    void record(int day, int minute, const std::string &command);
+
+    /**
+     * @brief Embeds the state a load command just restored, so the replay needs no file.
+     */
+    void loaded(const CarWash &state);
+
+    /**
+     * @brief Appends the digest of the final state; later records are ignored.
+     */
+    void finish(const CarWash &final);
+};
+
+/**
+ * @brief One recorded command.
+ */
+struct ReplayEntry {
+    int day{0};
+    int minute{0};
+    std::string command;
+    std::optional<std::string> loaded; /**< Snapshot restored by a successful load command. */
+};
+
+/**
+ * @brief Stands in for the file system while a log is replayed.
+ *
+ * save commands are serialized into an in-memory sink and dropped; load commands restore the
+ * snapshot recorded in the log, or fail as the session did. Replays therefore never read or
+ * write save files.
+ */
+class ReplaySandbox {
+    const std::string *loaded_{nullptr};
+
+public:
+    /**
+     * @brief Sets the snapshot the next load restores (nullptr: the load failed when recorded).
+     */
+    void expect(const std::string *snapshot) noexcept { loaded_ = snapshot; }
+
+    /**
+     * @throws SaveFileException If the recorded load failed.
+     */
+    [[nodiscard]] BinaryReader open(const std::string &path) const;
+
+    void store(const std::string &path, const BinaryWriter &snapshot) const noexcept {
+        (void) path;
+        (void) snapshot;
+    }
+};
+
+/**
+ * @brief Outcome of re-executing a command log.
+ */
+struct ReplayResult {
+    int executed{0}; /**< Commands executed. */
+    int firstDesync{-1}; /**< Index of the first command issued at another day/minute than recorded (-1 if none). */
+    std::uint64_t digest{0}; /**< Digest of the replayed final state. */
+    bool verified{false}; /**< The log was complete and the final digest matches. */
+    std::unique_ptr<CarWash> state; /**< Final replayed state (headless). */
+};
+
+/**
+ * @brief A command log read back from disk.
+ */
+struct ReplayLog {
+    static constexpr std::uint32_t MAGIC = 0x4C525743; /**< "CWRL" */
+    static constexpr std::uint32_t VERSION = 2;
+    static constexpr std::uint8_t TAG_COMMAND = 1;
+    static constexpr std::uint8_t TAG_END = 2;
+    static constexpr std::uint8_t TAG_LOADED = 3;
+
+    std::uint64_t seed{0};
+    std::string snapshot;
+    std::vector<ReplayEntry> entries;
+    bool complete{false}; /**< The closing record is present. */
+    std::uint64_t finalDigest{0};
+
+    /**
+     * @throws SaveFileException If the file is missing, corrupt or of another version.
+     */
+    static ReplayLog read(const std::string &path);
+
+    /**
+     * @brief Re-executes every command headless, as fast as possible, and checks the final state.
+     *
+     * Rejected commands are skipped exactly as they were in the session (their error is not printed).
+     * save and load go through a ReplaySandbox, never to disk.
+     */
+    [[nodiscard]] ReplayResult replay() const;
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+class DailyReport;
+struct JournalRecord;
+
+enum class ExportFormat : std::uint8_t { Csv, Binary };
+
+/**
+ * @brief A batch of rows of one table, stored column by column.
+ */
+class ColumnChunk {
+public:
+    using Data = std::variant<std::vector<std::int32_t>, std::vector<std::uint32_t>, std::vector<std::uint8_t>,
+        std::vector<float>, std::vector<double>, std::vector<std::string> >;
+
+    struct Column {
+        std::string name;
+        Data data;
+    };
+
+private:
+    std::vector<Column> columns_;
+    size_t rows_{0};
+
+public:
+    ColumnChunk() = default;
+
+    /**
+     * @brief Empty chunk with the same columns as schema.
+     */
+    static ColumnChunk like(const ColumnChunk &schema);
+
+    template<typename T>
+    void addColumn(std::string name) { columns_.push_back({std::move(name), std::vector<T>{}}); }
+
+    /**
+     * @brief Typed access to column i; T must match the declared type.
+     */
+    template<typename T>
+    std::vector<T> &col(size_t i) { return std::get<std::vector<T> >(columns_[i].data); }
+
+    /**
+     * @brief Closes the current row (every column must have received one value).
+     */
+    void endRow() noexcept { ++rows_; }
+
+    [[nodiscard]] const std::vector<Column> &columns() const noexcept { return columns_; }
+    [[nodiscard]] size_t rows() const noexcept { return rows_; }
+    [[nodiscard]] bool empty() const noexcept { return rows_ == 0; }
+
+    void reserve(size_t rows);
+};
+
+/**
+ * @brief Streams finalized daily reports (and optionally per-customer outcomes) to disk.
+ *
+ * Three tables are written: "<prefix>_days", "<prefix>_services" (one row per service and
+ * day) and, if enabled, "<prefix>_customers", as .csv or as .cwc binary columnar files.
+ * Rows are collected column-wise into chunks; full chunks are handed to a background writer
+ * thread that encodes and writes each one with a single write, so the simulation thread
+ * never formats text or touches the disk. At most MAX_PENDING chunks wait for the writer;
+ * beyond that the producer blocks instead of buffering without bound.
+ *
+ * Binary layout (little-endian): magic "CWCX", u16 version, u16 column count, then per
+ * column u8 type and a u32-length name; then chunks of u32 rows followed by every column's
+ * values (raw arrays; strings as u32 length + bytes). A chunk with 0 rows ends the file.
+ * CSV numbers use the shortest round-trip representation, so no precision is lost.
+ */
+class ReportExporter {
+public:
+    static constexpr std::uint32_t MAGIC = 0x58435743; /**< "CWCX" */
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr size_t MAX_PENDING = 4;
+
+    /**
+     * @param prefix Path prefix of the output files.
+     * @param format Output encoding.
+     * @param customers Whether per-customer outcomes are exported too.
+     * @param chunkRows Rows buffered per table before a chunk is handed to the writer.
+     * @throws ExportException If an output file cannot be created.
+     */
+    ReportExporter(const std::string &prefix, ExportFormat format, bool customers, size_t chunkRows = 4096);
+
+    /**
+     * @brief Flushes and stops the writer; errors are only reported by finish().
+     */
+    ~ReportExporter();
+
+    ReportExporter(const ReportExporter &) = delete;
+
+    ReportExporter &operator=(const ReportExporter &) = delete;
+
+    /**
+     * @brief Exports one finalized day (totals and per-service rows).
+     */
+    void addDay(const DailyReport &rep);
+
+    /**
+     * @brief Exports a Served or Lost journal record as a customer row (other types are ignored).
+     */
+    void addOutcome(const JournalRecord &r);
+
+    [[nodiscard]] bool exportsCustomers() const noexcept { return customers_; }
+
+    /**
+     * @brief Writes the partial chunks, waits for the writer and closes the files.
+     *
+     * @throws ExportException If the writer thread failed to write.
+     */
+    void finish();
+
+    [[nodiscard]] std::uint64_t daysExported() const noexcept { return days_; }
+    [[nodiscard]] std::uint64_t customersExported() const noexcept { return customerRows_; }
+
+private:
+    enum Table : size_t { Days, Services, Customers, TABLES };
+
+    struct Job {
+        size_t table{0};
+        ColumnChunk chunk;
+    };
+
+    ExportFormat format_;
+    bool customers_;
+    size_t chunkRows_;
+    ColumnChunk chunks_[TABLES];
+    std::ofstream files_[TABLES];
+    std::uint64_t days_{0};
+    std::uint64_t customerRows_{0};
+
+    std::thread writer_;
+    std::mutex m_;
+    std::condition_variable ready_; /**< Signals the writer: work queued or stop. */
+    std::condition_variable space_; /**< Signals the producer: a queue slot was freed. */
+    std::deque<Job> pending_;
+    bool stop_{false};
+    bool finished_{false};
+    std::string error_; /**< First write error (set by the writer). */
+
+    void submit(size_t table);
+
+    void writerLoop();
+
+    void encode(std::string &out, const ColumnChunk &chunk) const;
+
+    void encodeHeader(std::string &out, const ColumnChunk &schema) const;
+
+    void stopWriter();
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "DailyReport.h"
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @brief Columnar store of finalized daily reports.
+ *
+ * Every metric is one contiguous array with one entry per stored day, and the per-service
+ * figures form a day x service matrix (row-major, one column per interned service name).
+ * Appending a day copies a handful of numbers, and scanning a metric over years of history
+ * touches a single array. at() rebuilds a DailyReport when a whole day is needed.
+ */
+class ReportHistory {
+    std::vector<std::int32_t> day_;
+    std::vector<std::int32_t> cars_;
+    std::vector<std::int32_t> lost_;
+    std::vector<double> revenue_;
+    std::vector<double> satisfaction_;
+
+    std::shared_ptr<const ServiceKeys> keys_{std::make_shared<ServiceKeys>()};
+    size_t stride_{0}; /**< Matrix columns (services). */
+    std::vector<std::int32_t> serviceCars_; /**< size() x stride_. */
+    std::vector<double> serviceRevenue_; /**< size() x stride_. */
+
+    /**
+     * @brief Widens the matrix to cols columns, moving the existing rows.
+     */
+    void widen(size_t cols);
+
+public:
+    void append(const DailyReport &rep);
+
+    /**
+     * @brief Rebuilds the report of the i-th stored day.
+     */
+    [[nodiscard]] DailyReport at(size_t i) const;
+
+    /**
+     * @brief Copy of the days [from, size()).
+     */
+    [[nodiscard]] ReportHistory slice(size_t from) const;
+
+    [[nodiscard]] size_t size() const noexcept { return day_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return day_.empty(); }
+
+    [[nodiscard]] const std::vector<std::int32_t> &days() const noexcept { return day_; }
+    [[nodiscard]] const std::vector<std::int32_t> &cars() const noexcept { return cars_; }
+    [[nodiscard]] const std::vector<std::int32_t> &lost() const noexcept { return lost_; }
+    [[nodiscard]] const std::vector<double> &revenue() const noexcept { return revenue_; }
+    [[nodiscard]] const std::vector<double> &satisfaction() const noexcept { return satisfaction_; }
+
+    [[nodiscard]] const ServiceKeys &keys() const noexcept { return *keys_; }
+
+    [[nodiscard]] const std::shared_ptr<const ServiceKeys> &sharedKeys() const noexcept { return keys_; }
+
+    /**
+     * @brief Number of service columns of the matrix.
+     */
+    [[nodiscard]] size_t serviceColumns() const noexcept { return stride_; }
+
+    [[nodiscard]] std::int32_t serviceCars(size_t day, ServiceKey key) const {
+        return key < stride_ ? serviceCars_[day * stride_ + key] : 0;
+    }
+
+    [[nodiscard]] double serviceRevenue(size_t day, ServiceKey key) const {
+        return key < stride_ ? serviceRevenue_[day * stride_ + key] : 0.0;
+    }
+
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+
+    /**
+     * @brief Writes the service key table and the matrix width, without any row.
+     */
+    void saveLayout(BinaryWriter &w) const;
+
+    /**
+     * @brief Empties the history and restores a layout written by saveLayout().
+     */
+    void loadLayout(BinaryReader &r);
+
+    /**
+     * @brief Writes the days [from, size()), each with its own column count (see HistoryLog).
+     */
+    void saveRows(BinaryWriter &w, size_t from) const;
+
+    /**
+     * @brief Appends one row written by saveRows(); narrower rows are padded with zeros.
+     */
+    void loadRow(BinaryReader &r);
+};
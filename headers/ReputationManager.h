@@ -1,7 +1,66 @@
 #pragma once
 
+#include <cstddef>
+
 #include "../headers/RunningStat.h"
 
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @brief A run of customer outcomes folded into one closed-form reputation update.
+ *
+ * Serving a customer moves the score s to 0.8 * s + 0.2 * sat and losing one to
+ * max(0, s - 0.1). Both keep s inside [0, 5], so any sequence of them is the map
+ * s -> max(floor, a * s + b); the batch keeps only a, b and floor, so recording an outcome,
+ * a cohort of k equal outcomes or applying the whole batch are all O(1). The result equals
+ * the per-customer updates in the same order up to rounding.
+ */
+class ReputationBatch {
+    double scale_{1.0};
+    double offset_{0.0};
+    double floor_{0.0};
+    std::size_t outcomes_{0};
+    RunningStat<double> satisfaction_{};
+
+public:
+    static constexpr double DECAY = 0.8; /**< Weight kept by the old score on every served customer. */
+    static constexpr double WEIGHT = 0.2; /**< Weight of the customer's satisfaction. */
+    static constexpr double LOSS_PENALTY = 0.10;
+
+    /**
+     * @brief One served customer with satisfaction sat (0..5).
+     */
+    void served(double sat) noexcept;
+
+    /**
+     * @brief k served customers with the same satisfaction.
+     */
+    void served(double sat, std::size_t k);
+
+    void lost(std::size_t m = 1) noexcept;
+
+    /**
+     * @brief Score after the batch, starting from score (0..5).
+     */
+    [[nodiscard]] double apply(double score) const noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return outcomes_ == 0; }
+
+    /**
+     * @brief Served plus lost customers recorded so far.
+     */
+    [[nodiscard]] std::size_t outcomes() const noexcept { return outcomes_; }
+
+    [[nodiscard]] const RunningStat<double> &satisfaction() const noexcept { return satisfaction_; }
+};
+
+/**
+ * @brief Reputation score and satisfaction stats, updated one ReputationBatch at a time.
+ *
+ * The simulation collects each hour's customers into a batch and applies it once, so the
+ * score moves at hour (and day) boundaries.
+ */
 class ReputationManager {
     double score_{3.0}; // 0..5
     int events_{0};
@@ -10,17 +69,30 @@ class ReputationManager {
     RunningStat<int> servedCount_{};
 
 public:
-    void onServed(double satisfaction);
+    /**
+     * @brief Applies a batch of outcomes in one step.
+     */
+    void apply(const ReputationBatch &batch);
 
-    void onLost();
+    /**
+     * @brief Moves the score part of the way towards a target (chain-wide reputation).
+     *
+     * @param target Score to blend towards (0..5).
+     * @param weight Share of the target in the new score (0..1).
+     */
+    void blendToward(double target, double weight);
 
     double score() const noexcept { return score_; }
 
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+
     double avgSatisfaction() const noexcept {
         return satisfaction_.count() > 0 ? satisfaction_.average() : 0.0;
     }
 
     int totalServedSamples() const noexcept {
-        return servedCount_.count();
+        return static_cast<int>(servedCount_.count());
     }
 };
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief xoshiro256** pseudo-random generator with jump-ahead.
+ *
+ * Small (32 bytes of state), fast and owned by value, so every simulation instance can
+ * carry its own generators without any shared state. jump() advances the sequence by
+ * 2^128 draws, which yields non-overlapping sub-streams from a single seed. Satisfies
+ * UniformRandomBitGenerator, so it also works with <random>.
+ */
+class Rng {
+    std::array<std::uint64_t, 4> s_{};
+
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /**
+     * @brief Applies a jump polynomial (see the xoshiro reference implementation).
+     */
+    void applyJump(const std::array<std::uint64_t, 4> &poly) noexcept {
+        std::array<std::uint64_t, 4> t{};
+        for (std::uint64_t word: poly) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (std::uint64_t{1} << b)) {
+                    for (size_t i = 0; i < 4; ++i) t[i] ^= s_[i];
+                }
+                (*this)();
+            }
+        }
+        s_ = t;
+    }
+
+public:
+    using result_type = std::uint64_t;
+
+    explicit Rng(std::uint64_t seed = 0) noexcept { this->seed(seed); }
+
+    /**
+     * @brief Resets the state from a 64-bit seed expanded with SplitMix64.
+     */
+    void seed(std::uint64_t seed) noexcept {
+        for (auto &word: s_) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * @brief Raw generator state (for save files).
+     */
+    [[nodiscard]] const std::array<std::uint64_t, 4> &state() const noexcept { return s_; }
+
+    void setState(const std::array<std::uint64_t, 4> &s) noexcept { s_ = s; }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    /**
+     * @brief Next 64 random bits.
+     */
+    result_type operator()() noexcept {
+        const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Uniform integer in [lo, hi] (Lemire's multiply-shift with rejection, unbiased).
+     */
+    int uniformInt(int lo, int hi) noexcept {
+        const auto range = static_cast<std::uint32_t>(hi - lo) + 1U;
+        std::uint64_t m = ((*this)() >> 32) * range;
+        auto low = static_cast<std::uint32_t>(m);
+        if (low < range) {
+            const std::uint32_t threshold = (0U - range) % range;
+            while (low < threshold) {
+                m = ((*this)() >> 32) * range;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return lo + static_cast<int>(m >> 32);
+    }
+
+    /**
+     * @brief Advances the state by 2^128 draws (next independent sub-stream).
+     */
+    void jump() noexcept {
+        applyJump({0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL});
+    }
+};
+
+/**
+ * @brief Derives the seed of the i-th independent instance from a base seed.
+ *
+ * SplitMix64 finalizer over (base, index): neighbouring indices give unrelated seeds.
+ */
+inline std::uint64_t deriveSeed(std::uint64_t base, std::uint64_t index) noexcept {
+    std::uint64_t z = base + 0x9E3779B97F4A7C15ULL * (index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief The independent random sub-streams of one simulation instance.
+ *
+ * All three are derived from one seed by successive jumps, so drawing more customer
+ * attributes (for example) never shifts the arrival times or the daily events.
+ */
+struct RngStreams {
+    Rng arrivals; /**< Arrival times inside each hour. */
+    Rng customers; /**< Customer type, budget and impatience. */
+    Rng events; /**< Daily gameplay events (weather, holiday, inspection). */
+
+    explicit RngStreams(std::uint64_t seed = 0) noexcept { reseed(seed); }
+
+    void reseed(std::uint64_t seed) noexcept {
+        Rng base(seed);
+        arrivals = base;
+        base.jump();
+        customers = base;
+        base.jump();
+        events = base;
+    }
+};
@@ -1,20 +1,236 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
-template<typename T>
+/**
+ * @brief Streaming count / sum / mean / variance / min / max of a series, optionally with a histogram.
+ *
+ * The mean and the sum of squared deviations follow Welford's update, so the variance stays
+ * accurate over tens of millions of samples; floating-point sums are Neumaier-compensated and
+ * integral sums are exact. Two stats collected separately (per thread, per replica) can be
+ * combined with merge() (Chan et al.), which gives the same count, sum, extremes and histogram
+ * as feeding every sample to one stat, and the same mean / variance up to rounding.
+ *
+ * Everything lives inline (the histogram is a std::array), so add() never allocates.
+ *
+ * @tparam T Sample type (arithmetic).
+ * @tparam Buckets Number of fixed-width histogram buckets over [lo, hi); 0 disables the histogram.
+ */
+template<typename T, std::size_t Buckets = 0>
 class RunningStat {
-    T sum_{};
+    static_assert(std::is_arithmetic_v<T>);
+
+    struct NoHistogram {
+    };
+
+    using Histogram = std::conditional_t<(Buckets > 0), std::array<std::uint64_t, Buckets>, NoHistogram>;
+
     std::size_t count_{0};
+    T sum_{};
+    T comp_{}; // Neumaier compensation (always 0 for integral T)
+    double mean_{0.0};
+    double m2_{0.0};
+    T min_{};
+    T max_{};
+    double lo_{0.0};
+    double hi_{1.0};
+    [[no_unique_address]] Histogram hist_{};
+
+    void addToSum(const T &v) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            const T t = sum_ + v;
+            if (std::abs(sum_) >= std::abs(v)) comp_ += (sum_ - t) + v;
+            else comp_ += (v - t) + sum_;
+            sum_ = t;
+        } else {
+            sum_ += v;
+        }
+    }
 
 public:
-    void add(const T &v) {
-        sum_ += v;
+    static constexpr std::size_t BUCKETS = Buckets;
+
+    RunningStat() = default;
+
+    /**
+     * @brief Stat whose histogram covers [lo, hi) (samples outside are clamped to the end buckets).
+     */
+    RunningStat(double lo, double hi) noexcept : lo_(lo), hi_(hi > lo ? hi : lo + 1.0) {
+    }
+
+    void add(const T &v) noexcept {
+        if (count_ == 0) {
+            min_ = v;
+            max_ = v;
+        } else {
+            min_ = std::min(min_, v);
+            max_ = std::max(max_, v);
+        }
         ++count_;
+        addToSum(v);
+
+        const double x = static_cast<double>(v);
+        const double delta = x - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (x - mean_);
+
+        if constexpr (Buckets > 0) ++hist_[bucketOf(x)];
+    }
+
+    /**
+     * @brief Adds n copies of v in O(1) (same result as merging a stat of n equal samples).
+     */
+    void add(const T &v, std::size_t n) noexcept {
+        if (n == 0) return;
+        if (count_ == 0) {
+            min_ = v;
+            max_ = v;
+        } else {
+            min_ = std::min(min_, v);
+            max_ = std::max(max_, v);
+        }
+        const double before = static_cast<double>(count_);
+        count_ += n;
+        addToSum(static_cast<T>(v * static_cast<T>(n)));
+
+        const double x = static_cast<double>(v);
+        const double share = static_cast<double>(n) / static_cast<double>(count_);
+        const double delta = x - mean_;
+        mean_ += delta * share;
+        m2_ += delta * delta * before * share;
+
+        if constexpr (Buckets > 0) hist_[bucketOf(x)] += n;
+    }
+
+    /**
+     * @brief Folds in another stat; histograms must share the same range.
+     */
+    void merge(const RunningStat &o) noexcept {
+        if (o.count_ == 0) return;
+        if (count_ == 0) {
+            const double lo = lo_, hi = hi_;
+            *this = o;
+            lo_ = lo;
+            hi_ = hi;
+            return;
+        }
+        const double n = static_cast<double>(count_ + o.count_);
+        const double delta = o.mean_ - mean_;
+        mean_ += delta * (static_cast<double>(o.count_) / n);
+        m2_ += o.m2_ + delta * delta * (static_cast<double>(count_) * static_cast<double>(o.count_) / n);
+        count_ += o.count_;
+
+        addToSum(o.sum_);
+        if constexpr (std::is_floating_point_v<T>) comp_ += o.comp_;
+
+        min_ = std::min(min_, o.min_);
+        max_ = std::max(max_, o.max_);
+
+        if constexpr (Buckets > 0) {
+            for (std::size_t b = 0; b < Buckets; ++b) hist_[b] += o.hist_[b];
+        }
+    }
+
+    void reset() noexcept {
+        *this = RunningStat(lo_, hi_);
     }
 
-    std::size_t count() const noexcept { return count_; }
+    [[nodiscard]] std::size_t count() const noexcept { return count_; }
+
+    /**
+     * @brief Compensated sum of the samples.
+     */
+    [[nodiscard]] T sum() const noexcept { return sum_ + comp_; }
+
+    [[nodiscard]] double average() const noexcept {
+        return count_ ? static_cast<double>(sum()) / static_cast<double>(count_) : 0.0;
+    }
+
+    /**
+     * @brief Welford running mean (0 without samples).
+     */
+    [[nodiscard]] double mean() const noexcept { return mean_; }
+
+    /**
+     * @brief Population variance (0 with fewer than two samples).
+     */
+    [[nodiscard]] double variance() const noexcept {
+        return count_ > 1 ? m2_ / static_cast<double>(count_) : 0.0;
+    }
+
+    /**
+     * @brief Unbiased sample variance (0 with fewer than two samples).
+     */
+    [[nodiscard]] double sampleVariance() const noexcept {
+        return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0;
+    }
+
+    [[nodiscard]] double stddev() const noexcept { return std::sqrt(variance()); }
+
+    /**
+     * @brief Smallest / largest sample (T{} without samples).
+     */
+    [[nodiscard]] T min() const noexcept { return min_; }
+    [[nodiscard]] T max() const noexcept { return max_; }
+
+    [[nodiscard]] double histogramLow() const noexcept { return lo_; }
+    [[nodiscard]] double histogramHigh() const noexcept { return hi_; }
+
+    /**
+     * @brief Bucket a value falls into (clamped to the first / last bucket).
+     */
+    [[nodiscard]] std::size_t bucketOf(double x) const noexcept requires (Buckets > 0) {
+        const double pos = (x - lo_) / (hi_ - lo_) * static_cast<double>(Buckets);
+        if (!(pos > 0.0)) return 0;
+        if (pos >= static_cast<double>(Buckets)) return Buckets - 1;
+        return static_cast<std::size_t>(pos);
+    }
+
+    [[nodiscard]] std::uint64_t bucket(std::size_t b) const noexcept requires (Buckets > 0) { return hist_[b]; }
+
+    [[nodiscard]] const std::array<std::uint64_t, Buckets> &histogram() const noexcept requires (Buckets > 0) {
+        return hist_;
+    }
+
+    /**
+     * @brief Writes the full state (BinaryWriter or any writer with pod()).
+     */
+    template<typename Writer>
+    void save(Writer &w) const {
+        w.pod(static_cast<std::uint64_t>(count_));
+        w.pod(sum_);
+        w.pod(comp_);
+        w.pod(mean_);
+        w.pod(m2_);
+        w.pod(min_);
+        w.pod(max_);
+        if constexpr (Buckets > 0) {
+            w.pod(lo_);
+            w.pod(hi_);
+            for (std::uint64_t c: hist_) w.pod(c);
+        }
+    }
 
-    double average() const noexcept {
-        return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+    /**
+     * @brief Restores a state written by save().
+     */
+    template<typename Reader>
+    void load(Reader &r) {
+        count_ = static_cast<std::size_t>(r.template pod<std::uint64_t>());
+        sum_ = r.template pod<T>();
+        comp_ = r.template pod<T>();
+        mean_ = r.template pod<double>();
+        m2_ = r.template pod<double>();
+        min_ = r.template pod<T>();
+        max_ = r.template pod<T>();
+        if constexpr (Buckets > 0) {
+            lo_ = r.template pod<double>();
+            hi_ = r.template pod<double>();
+            for (std::uint64_t &c: hist_) c = r.template pod<std::uint64_t>();
+        }
     }
 };
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Inventory.h"
+#include "WashBay.h"
+#include "WashService.h"
+
+class CarWash;
+
+/**
+ * @brief Reusable description of a car wash setup.
+ *
+ * Holds the prototypes (inventory, opening hours, services, bays) and the initial
+ * management decisions (pricing mode, upgrades bought on day one). build() is const and
+ * only reads the prototypes, so many independent CarWash instances can be built from the
+ * same scenario concurrently.
+ */
+class Scenario {
+    std::string name_;
+    Inventory inventory_;
+    int openMin_;
+    int closeMin_;
+    std::vector<std::unique_ptr<WashService> > services_;
+    std::vector<WashBay> bays_;
+
+    double startCash_{0.0};
+    std::string pricingMode_{"balanced"};
+    std::vector<int> upgrades_;
+
+public:
+    /**
+     * @brief Creates an empty scenario.
+     *
+     * @param name Car wash display name.
+     * @param inv Initial inventory.
+     * @param openM Opening time in minutes since midnight.
+     * @param closeM Closing time in minutes since midnight.
+     */
+    Scenario(std::string name, Inventory inv, int openM, int closeM);
+
+    /**
+     * @brief The standard game setup: 5 services and 3 bays, open 08:00-12:00.
+     *
+     * @throws CarWashException If the service factory cannot create a service.
+     */
+    static Scenario makeDefault();
+
+    void addService(const WashService &s) { services_.push_back(s.clone()); }
+    void addBay(const WashBay &b) { bays_.push_back(b); }
+
+    void setStartCash(double cash) noexcept { startCash_ = cash; }
+    void setPricingMode(std::string mode) { pricingMode_ = std::move(mode); }
+    void addUpgrade(int id) { upgrades_.push_back(id); }
+
+    const std::string &name() const noexcept { return name_; }
+    int openMin() const noexcept { return openMin_; }
+    int bayCount() const noexcept { return static_cast<int>(bays_.size()); }
+    const Inventory &inventory() const noexcept { return inventory_; }
+
+    /**
+     * @brief Builds a fresh CarWash instance from this scenario.
+     *
+     * Starting cash is granted, then the pricing mode and the upgrades are applied.
+     *
+     * @param out Console stream of the instance, or nullptr for a headless instance.
+     * @return Newly built simulation.
+     *
+     * @throws CarWashException If the hours are invalid or an upgrade cannot be afforded.
+     */
+    std::unique_ptr<CarWash> build(std::ostream *out) const;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Customer.h"
+
+class WashService;
+
+/**
+ * @brief Precomputed answer of Customer::chooseService for every customer type and budget.
+ *
+ * For a fixed catalog the choice of a customer depends only on its type and on the set
+ * of services it can afford, which only changes when the budget crosses a service price.
+ * The index keeps, per customer type, the distinct prices sorted ascending and the service
+ * chosen by that type with a budget equal to each price, so a lookup is one binary search.
+ *
+ * The tables are computed by the real chooseService overrides, so tie-breaking and the
+ * catalog order are preserved exactly. refresh() rebuilds them when a service was added or
+ * any WashService::revision() moved (price or rating changed).
+ */
+class ServiceChoiceIndex {
+    struct Table {
+        std::vector<double> breaks; /**< Distinct service prices, ascending. */
+        std::vector<int> choice; /**< Catalog index chosen for a budget in [breaks[i], breaks[i + 1]) (-1 = none). */
+    };
+
+    std::array<Table, 4> tables_;
+    size_t serviceCount_{0};
+    std::uint64_t revisionSum_{0};
+    bool valid_{false};
+
+    static std::uint64_t revisionSum(const std::vector<WashService *> &services);
+
+    void rebuild(const std::vector<WashService *> &services);
+
+public:
+    /**
+     * @brief Forces a rebuild at the next refresh().
+     */
+    void invalidate() noexcept { valid_ = false; }
+
+    /**
+     * @brief Rebuilds the tables if the catalog changed since the last build.
+     *
+     * O(services) when nothing changed; call it before a batch of lookups.
+     */
+    void refresh(const std::vector<WashService *> &services);
+
+    /**
+     * @brief Catalog index of the service chosen by a customer of the given type and budget.
+     *
+     * @return Index in the vector passed to refresh(), or -1 if the customer cannot afford any service.
+     */
+    [[nodiscard]] int choose(CustomerType type, double budget) const;
+};
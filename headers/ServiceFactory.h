@@ -5,6 +5,8 @@
 
 #include "WashService.h"
 
+class BinaryReader;
+
 class ServiceFactory {
 public:
     enum class Kind { Basic, Deluxe, Wax, Eco };
@@ -20,4 +22,11 @@ public:
         int shampooNeed,
         int waxNeed,
         double rating = -1.0);
+
+    /**
+     * @brief Rebuilds a service written by WashService::save().
+     *
+     * @throws SaveFileException If the record is invalid.
+     */
+    static std::unique_ptr<WashService> load(BinaryReader &r);
 };
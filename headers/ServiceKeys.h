@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Dense id of an interned service name (index into per-service arrays).
+ */
+using ServiceKey = std::uint16_t;
+
+/**
+ * @brief Intern table of service names used to key per-service statistics.
+ *
+ * Ids are handed out in first-seen order and never change, so a newer table always extends
+ * an older one and arrays indexed by id only ever grow. Services with the same name share
+ * one id, exactly as they shared one entry of the former name-keyed map.
+ */
+class ServiceKeys {
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, ServiceKey> ids_;
+
+public:
+    /**
+     * @brief Returns the id of name, adding it if it is new.
+     */
+    ServiceKey intern(const std::string &name) {
+        const auto [it, inserted] = ids_.try_emplace(name, static_cast<ServiceKey>(names_.size()));
+        if (inserted) names_.push_back(name);
+        return it->second;
+    }
+
+    /**
+     * @brief Id of name, or -1 if it was never interned.
+     */
+    [[nodiscard]] int find(const std::string &name) const {
+        const auto it = ids_.find(name);
+        return it == ids_.end() ? -1 : it->second;
+    }
+
+    [[nodiscard]] const std::string &name(ServiceKey key) const { return names_[key]; }
+
+    [[nodiscard]] size_t size() const noexcept { return names_.size(); }
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @brief Kinds of timestamped events driving the discrete-event simulation clock.
+ *
+ * The numeric order is also the processing order for events that share the same minute:
+ * a bay that frees up at minute t can take a customer arriving at t, and closing/day-end
+ * always run after every other event of that minute.
+ */
+enum class SimEventType : std::uint8_t {
+    BayFinished = 0, /**< A wash bay finished its current car (payload = bay index). */
+    Arrival = 1, /**< A customer joined the waiting queue. */
+    Closing = 2, /**< The car wash closes; customers still waiting are lost. */
+    DayEnd = 3 /**< The simulated day is finalized. */
+};
+
+/**
+ * @brief One scheduled event of the simulation.
+ */
+struct SimEvent {
+    int minute{0}; /**< Simulated minute since midnight at which the event fires. */
+    SimEventType type{SimEventType::Arrival};
+    int payload{-1}; /**< Event-specific data (bay index for BayFinished). */
+    std::uint64_t seq{0}; /**< Insertion order, keeps equal events FIFO. */
+};
+
+/**
+ * @brief Min-priority queue of SimEvent ordered by (minute, type, insertion order).
+ *
+ * Backed by a binary heap in a std::vector, so scheduling and popping are O(log n)
+ * and the simulation cost grows with the number of events rather than with the
+ * number of simulated minutes.
+ */
+class SimEventQueue {
+    std::vector<SimEvent> heap_;
+    std::uint64_t nextSeq_{0};
+
+    static bool later(const SimEvent &a, const SimEvent &b) noexcept;
+
+public:
+    SimEventQueue() = default;
+
+    /**
+     * @brief Schedules a new event.
+     *
+     * @param minute Minute at which the event fires.
+     * @param type Event type.
+     * @param payload Optional event-specific data.
+     */
+    void schedule(int minute, SimEventType type, int payload = -1);
+
+    /**
+     * @brief Returns the earliest pending event. Must not be called when empty().
+     */
+    [[nodiscard]] const SimEvent &top() const { return heap_.front(); }
+
+    /**
+     * @brief Removes and returns the earliest pending event. Must not be called when empty().
+     */
+    SimEvent pop();
+
+    [[nodiscard]] bool empty() const noexcept { return heap_.empty(); }
+    [[nodiscard]] int size() const noexcept { return static_cast<int>(heap_.size()); }
+
+    /**
+     * @brief Drops every pending event.
+     */
+    void clear() noexcept { heap_.clear(); }
+
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+};
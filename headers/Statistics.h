@@ -1,26 +1,44 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <map>
+#include <memory>
 #include <iosfwd>
 
-#include "DailyReport.h"
-
-struct ServiceAggregate {
-    int cars{0};
-    double revenue{0.0};
-};
-
+#include "ReportHistory.h"
+#include "StatsAggregator.h"
+#include "StreamingStats.h"
+
+/**
+ * @brief Read-only analytics over a report history.
+ *
+ * Totals, averages, best / worst days and top services come from a StatsAggregator kept
+ * up to date by the owner of the history, so building a Statistics copies neither the
+ * history (it is shared) nor rescans it. Moving windows, EWMAs and quantiles come from
+ * the owner's StreamingStats. Only the per-day series walk the history.
+ */
 class Statistics {
-    std::vector<DailyReport> reports_;
-
-    static std::map<std::string, ServiceAggregate> aggregateServices(const std::vector<DailyReport> &reps);
+    std::shared_ptr<const ReportHistory> history_;
+    StatsAggregator agg_;
+    StreamingStats streaming_;
 
     static double safeDiv(double a, double b);
 
 public:
-    explicit Statistics(std::vector<DailyReport> reps);
+    /**
+     * @param history History to analyze (shared, not copied).
+     * @param agg Aggregate of exactly that history.
+     * @param streaming Streaming analytics fed alongside that history.
+     */
+    Statistics(std::shared_ptr<const ReportHistory> history, StatsAggregator agg, StreamingStats streaming);
+
+    /**
+     * @brief Takes a standalone history and aggregates it in one pass.
+     *
+     * The per-customer satisfaction sketch stays empty (a history has no per-customer data).
+     */
+    explicit Statistics(ReportHistory reps);
 
     int days() const noexcept;
 
@@ -54,11 +72,20 @@ public:
 
     std::vector<std::pair<std::string, ServiceAggregate> > topServicesByCars(int k) const;
 
-    std::vector<double> revenueSeries() const;
+    const std::vector<double> &revenueSeries() const noexcept;
+
+    const std::vector<double> &satisfactionSeries() const noexcept;
+
+    const std::vector<std::int32_t> &lostSeries() const noexcept;
+
+    [[nodiscard]] const StreamingStats &streaming() const noexcept { return streaming_; }
 
-    std::vector<double> satisfactionSeries() const;
+    void printSummary(std::ostream &os) const;
 
-    std::vector<int> lostSeries() const;
+    /**
+     * @brief Prints the moving windows, EWMAs and quantile estimates.
+     */
+    void printTrends(std::ostream &os) const;
 
     void print(std::ostream &os) const;
 };
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ServiceKeys.h"
+
+class ReportHistory;
+class ThreadPool;
+
+struct ServiceAggregate {
+    int cars{0};
+    double revenue{0.0};
+};
+
+/**
+ * @brief Running totals over a report history, updated once per finished day.
+ *
+ * Keeps the sums, the best / worst day of every metric, the first / last values (for the
+ * trend) and one aggregate per service key, so every figure of the statistics summary is
+ * read in O(1) and top-k only sorts the (small) service array. Sums are accumulated in day
+ * order, exactly as a full rescan of the history would.
+ */
+class StatsAggregator {
+public:
+    /**
+     * @brief Extreme value of one metric and the first day it was reached.
+     */
+    template<typename T>
+    struct Extreme {
+        T value{};
+        int day{0};
+    };
+
+private:
+    int days_{0};
+    int totalCars_{0};
+    int totalLost_{0};
+    double totalRevenue_{0.0};
+    double weightedSat_{0.0};
+    double satWeight_{0.0};
+
+    Extreme<double> maxRevenue_, minRevenue_;
+    Extreme<double> maxSat_, minSat_;
+    Extreme<int> maxLost_, minLost_;
+
+    double firstRevenue_{0.0}, lastRevenue_{0.0};
+    double firstSat_{0.0}, lastSat_{0.0};
+    int firstLost_{0}, lastLost_{0};
+
+    std::vector<ServiceAggregate> services_; /**< Indexed by the history's service keys. */
+    std::shared_ptr<const ServiceKeys> keys_{std::make_shared<ServiceKeys>()};
+
+public:
+    StatsAggregator() = default;
+
+    /**
+     * @brief Aggregates a whole history (one pass; used after loading or slicing).
+     */
+    explicit StatsAggregator(const ReportHistory &history);
+
+    /**
+     * @brief Aggregates a whole history column by column with the Reductions kernels.
+     *
+     * Much faster than replaying add() on long histories, but revenue and satisfaction sums
+     * are reassociated, so they may differ from the incremental aggregate in the last bits.
+     * Used where a history is analyzed on its own (what-if projections), not where it must
+     * match a running aggregate.
+     *
+     * @param pool Optional pool for splitting long columns.
+     */
+    static StatsAggregator scan(const ReportHistory &history, ThreadPool *pool = nullptr);
+
+    /**
+     * @brief Folds in day row of history. Rows must be added in order, all from the same history.
+     */
+    void add(const ReportHistory &history, size_t row);
+
+    [[nodiscard]] int days() const noexcept { return days_; }
+    [[nodiscard]] int totalCars() const noexcept { return totalCars_; }
+    [[nodiscard]] int totalLost() const noexcept { return totalLost_; }
+    [[nodiscard]] double totalRevenue() const noexcept { return totalRevenue_; }
+
+    /**
+     * @brief Sum of satisfaction * cars and sum of cars, for the car-weighted average.
+     */
+    [[nodiscard]] double weightedSatisfaction() const noexcept { return weightedSat_; }
+    [[nodiscard]] double satisfactionWeight() const noexcept { return satWeight_; }
+
+    [[nodiscard]] const Extreme<double> &maxRevenue() const noexcept { return maxRevenue_; }
+    [[nodiscard]] const Extreme<double> &minRevenue() const noexcept { return minRevenue_; }
+    [[nodiscard]] const Extreme<double> &maxSatisfaction() const noexcept { return maxSat_; }
+    [[nodiscard]] const Extreme<double> &minSatisfaction() const noexcept { return minSat_; }
+    [[nodiscard]] const Extreme<int> &maxLost() const noexcept { return maxLost_; }
+    [[nodiscard]] const Extreme<int> &minLost() const noexcept { return minLost_; }
+
+    /**
+     * @brief Last minus first value of each series (0 with fewer than two days).
+     */
+    [[nodiscard]] double revenueTrend() const noexcept { return days_ >= 2 ? lastRevenue_ - firstRevenue_ : 0.0; }
+    [[nodiscard]] double satisfactionTrend() const noexcept { return days_ >= 2 ? lastSat_ - firstSat_ : 0.0; }
+    [[nodiscard]] int lostTrend() const noexcept { return days_ >= 2 ? lastLost_ - firstLost_ : 0; }
+
+    /**
+     * @brief The k services (with at least one car) ranked by revenue, ties broken by name.
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, ServiceAggregate> > topByRevenue(int k) const;
+
+    /**
+     * @brief The k services (with at least one car) ranked by cars, ties broken by name.
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, ServiceAggregate> > topByCars(int k) const;
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @brief Mean, min and max of the last N samples, kept in a fixed ring buffer.
+ *
+ * The running sum is re-summed from the ring each time it wraps, so rounding drift from
+ * the add/subtract updates never accumulates over long runs.
+ */
+class RollingWindow {
+    std::vector<double> ring_;
+    size_t head_{0}; /**< Slot of the next sample. */
+    size_t count_{0};
+    double sum_{0.0};
+
+public:
+    explicit RollingWindow(size_t capacity);
+
+    void add(double x);
+
+    [[nodiscard]] size_t capacity() const noexcept { return ring_.size(); }
+    [[nodiscard]] size_t size() const noexcept { return count_; }
+    [[nodiscard]] bool full() const noexcept { return count_ == ring_.size(); }
+
+    /**
+     * @brief Mean of the samples in the window (0 if empty).
+     */
+    [[nodiscard]] double mean() const noexcept;
+
+    [[nodiscard]] double min() const noexcept;
+
+    [[nodiscard]] double max() const noexcept;
+
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+};
+
+/**
+ * @brief Exponentially weighted moving average; the first sample seeds it.
+ */
+class Ewma {
+    double alpha_;
+    double value_{0.0};
+    bool seeded_{false};
+
+public:
+    explicit Ewma(double alpha) : alpha_(alpha) {
+    }
+
+    void add(double x) noexcept {
+        value_ = seeded_ ? value_ + alpha_ * (x - value_) : x;
+        seeded_ = true;
+    }
+
+    [[nodiscard]] double value() const noexcept { return value_; }
+
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+};
+
+/**
+ * @brief P-square estimate of one quantile in constant memory (Jain & Chlamtac, 1985).
+ *
+ * Five markers track the minimum, p/2, p, (1+p)/2 and the maximum; every sample moves
+ * them with a piecewise-parabolic step. Until five samples arrived the exact value of
+ * the stored samples is returned.
+ */
+class P2Quantile {
+    double p_;
+    std::uint64_t count_{0};
+    std::array<double, 5> q_{}; /**< Marker heights (the first samples, sorted, until count_ == 5). */
+    std::array<double, 5> n_{}; /**< Actual marker positions. */
+    std::array<double, 5> want_{}; /**< Desired marker positions. */
+
+    [[nodiscard]] double parabolic(int i, double d) const noexcept;
+
+    [[nodiscard]] double linear(int i, int d) const noexcept;
+
+public:
+    explicit P2Quantile(double p) : p_(p) {
+    }
+
+    void add(double x);
+
+    [[nodiscard]] double value() const noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+};
+
+/**
+ * @brief p10 / p50 / p90 of one stream of samples.
+ */
+struct QuantileBand {
+    P2Quantile p10{0.10};
+    P2Quantile p50{0.50};
+    P2Quantile p90{0.90};
+
+    void add(double x) {
+        p10.add(x);
+        p50.add(x);
+        p90.add(x);
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return p50.count(); }
+
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+};
+
+/**
+ * @brief Bounded-memory analytics updated as the simulation runs.
+ *
+ * For daily revenue, lost customers and satisfaction: 7-, 30- and 90-day moving windows and
+ * an EWMA. Quantile sketches cover daily revenue and the satisfaction of every served
+ * customer. Memory does not grow with the run length and every figure is read without
+ * touching the report history.
+ */
+class StreamingStats {
+public:
+    static constexpr std::array<size_t, 3> WINDOWS{7, 30, 90};
+    static constexpr double EWMA_ALPHA = 0.25; /**< About a 7-day span. */
+
+    /**
+     * @brief Windows and EWMA of one daily metric.
+     */
+    struct Metric {
+        std::array<RollingWindow, WINDOWS.size()> windows{
+            RollingWindow(WINDOWS[0]), RollingWindow(WINDOWS[1]), RollingWindow(WINDOWS[2])
+        };
+        Ewma ewma{EWMA_ALPHA};
+
+        void add(double x);
+
+        void save(BinaryWriter &w) const;
+
+        void load(BinaryReader &r);
+    };
+
+private:
+    Metric revenue_;
+    Metric lost_;
+    Metric satisfaction_;
+    QuantileBand dailyRevenue_;
+    QuantileBand customerSatisfaction_;
+
+public:
+    /**
+     * @brief Folds in the totals of one finished day.
+     */
+    void addDay(double revenue, int lost, double avgSatisfaction);
+
+    /**
+     * @brief Folds in the satisfaction of one served customer.
+     */
+    void addCustomer(double satisfaction) { customerSatisfaction_.add(satisfaction); }
+
+    [[nodiscard]] const Metric &revenue() const noexcept { return revenue_; }
+    [[nodiscard]] const Metric &lost() const noexcept { return lost_; }
+    [[nodiscard]] const Metric &satisfaction() const noexcept { return satisfaction_; }
+    [[nodiscard]] const QuantileBand &dailyRevenue() const noexcept { return dailyRevenue_; }
+    [[nodiscard]] const QuantileBand &customerSatisfaction() const noexcept { return customerSatisfaction_; }
+
+    void save(BinaryWriter &w) const;
+
+    void load(BinaryReader &r);
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads running index-parallel loops with work stealing.
+ *
+ * parallelFor(n, fn) calls fn(0) .. fn(n - 1) exactly once each, spread over the workers
+ * and the calling thread, and returns when all calls finished. Every thread starts with a
+ * contiguous block of indices and works through it front to back; a thread that runs out
+ * steals the back half of the largest remaining block, so uneven tasks still balance while
+ * neighbouring indices mostly stay on one thread. Callers that need thread-count independent
+ * results must write each result to its own slot (indexed by i) and reduce afterwards.
+ *
+ * parallelFor must not be called from inside a task of the same pool.
+ */
+class ThreadPool {
+    std::vector<std::thread> workers_;
+
+    std::mutex m_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_{0};
+    int busy_{0};
+    bool stop_{false};
+
+    /**
+     * @brief Remaining index block [begin, end) of one thread, packed for single-word CAS.
+     */
+    struct alignas(64) Block {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    const std::function<void(int)> *job_{nullptr};
+    std::unique_ptr<Block[]> blocks_; /**< One per participant; 0 is the calling thread. */
+
+    std::mutex errorM_;
+    std::exception_ptr error_;
+
+    static std::uint64_t pack(std::uint32_t begin, std::uint32_t end) noexcept {
+        return (static_cast<std::uint64_t>(begin) << 32) | end;
+    }
+
+    void workerLoop(int self);
+
+    void drain(int self);
+
+    bool takeOwn(int self, int &index);
+
+    bool steal(int self);
+
+public:
+    /**
+     * @brief Starts the pool.
+     *
+     * @param threads Total threads including the caller; <= 0 uses hardware_concurrency().
+     */
+    explicit ThreadPool(int threads = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Number of threads taking part in parallelFor (workers + caller).
+     */
+    [[nodiscard]] int size() const noexcept { return static_cast<int>(workers_.size()) + 1; }
+
+    /**
+     * @brief Runs fn(i) for every i in [0, n) and waits for completion.
+     *
+     * @param n Number of tasks.
+     * @param fn Task body; the first exception thrown by any task is rethrown here.
+     */
+    void parallelFor(int n, const std::function<void(int)> &fn);
+};
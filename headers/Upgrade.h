@@ -10,6 +10,9 @@ class Upgrade {
 public:
     virtual ~Upgrade() = default;
 
+    // id-ul folosit de comanda buyupgrade si in salvari
+    virtual int id() const = 0;
+
     virtual std::string name() const = 0;
 
     virtual std::string description() const = 0;
@@ -19,12 +22,17 @@ public:
     virtual void apply(CarWash &cw) const = 0;
 
     virtual void print(std::ostream &os) const;
+
+    // nullptr pentru id necunoscut
+    static std::unique_ptr<Upgrade> create(int id);
 };
 
 std::ostream &operator<<(std::ostream &os, const Upgrade &up);
 
 class BaySpeedUpgrade final : public Upgrade {
 public:
+    int id() const override { return 1; }
+
     std::string name() const override;
 
     std::string description() const override;
@@ -36,6 +44,8 @@ public:
 
 class ComfortUpgrade final : public Upgrade {
 public:
+    int id() const override { return 2; }
+
     std::string name() const override;
 
     std::string description() const override;
@@ -47,6 +57,8 @@ public:
 
 class MarketingUpgrade final : public Upgrade {
 public:
+    int id() const override { return 3; }
+
     std::string name() const override;
 
     std::string description() const override;
@@ -58,6 +70,8 @@ public:
 
 class NanoCoatingUpgrade final : public Upgrade {
 public:
+    int id() const override { return 4; }
+
     std::string name() const override;
 
     std::string description() const override;
@@ -1,18 +1,23 @@
 #pragma once
+#include <atomic>
 #include <string>
 #include <iosfwd>
 
-class WashService;
+#include "WashService.h"
+
+class BinaryWriter;
+class BinaryReader;
 
 class WashBay {
     int id_;
     int availMin_;
     char *label_;
-    bool canBasic_{true};
-    bool canDeluxe_{false};
-    bool canWax_{false};
+    ServiceKindMask caps_{kBasicCaps};
+
+    /** Basic bays also run Eco washes. */
+    static constexpr ServiceKindMask kBasicCaps = kindBit(ServiceKind::Basic) | kindBit(ServiceKind::Eco);
 
-    static int bayCount_;
+    static std::atomic<int> bayCount_;
 
     char *dup(const std::string &s);
 
@@ -27,20 +32,33 @@ public:
 
     int id() const noexcept { return id_; }
     int availAt() const noexcept { return availMin_; }
-    bool hasBasic() const noexcept { return canBasic_; }
-    bool hasDeluxe() const noexcept { return canDeluxe_; }
-    bool hasWax() const noexcept { return canWax_; }
+    bool hasBasic() const noexcept { return (caps_ & kBasicCaps) != 0; }
+    bool hasDeluxe() const noexcept { return (caps_ & kindBit(ServiceKind::Deluxe)) != 0; }
+    bool hasWax() const noexcept { return (caps_ & kindBit(ServiceKind::Wax)) != 0; }
+    ServiceKindMask capabilities() const noexcept { return caps_; }
+    const char *label() const noexcept { return label_; }
+
+    void addDeluxe() noexcept { caps_ |= kindBit(ServiceKind::Deluxe); }
+    void addWax() noexcept { caps_ |= kindBit(ServiceKind::Wax); }
 
-    void addDeluxe() noexcept { canDeluxe_ = true; }
-    void addWax() noexcept { canWax_ = true; }
+    bool canDo(ServiceKind k) const noexcept { return (caps_ & kindBit(k)) != 0; }
 
+    /**
+     * @brief Name-based wrapper over canDo(ServiceKind) ("Basic", "Eco", "Deluxe", "Wax").
+     */
     bool canDo(const std::string &n) const;
 
-    int bookOne(const WashService &sp, int earliest);
+    int bookOne(const WashService &sp, int earliest, double speedFactor = 1.0);
+
+    static int durationFor(const WashService &sp, double speedFactor);
 
     void reset(int openMin) { availMin_ = openMin; }
 
     static int totalBaysCreated() noexcept { return bayCount_; }
 
+    void save(BinaryWriter &w) const;
+
+    static WashBay load(BinaryReader &r);
+
     friend std::ostream &operator<<(std::ostream &, const WashBay &);
 };
@@ -1,11 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <iosfwd>
 
+class BinaryWriter;
+
 enum class ServiceKind { Basic, Deluxe, Wax, Eco, Custom };
 
+/**
+ * @brief Set of ServiceKind values, one bit per kind (see kindBit()).
+ */
+using ServiceKindMask = std::uint8_t;
+
+constexpr ServiceKindMask kindBit(ServiceKind k) noexcept {
+    return static_cast<ServiceKindMask>(1U << static_cast<unsigned>(k));
+}
+
 class WashService {
 protected:
     std::string name_;
@@ -16,6 +28,7 @@ protected:
     int needX_{0};
     double rating_{0.0};
     ServiceKind kind_{ServiceKind::Custom};
+    std::uint32_t revision_{0};
 
 public:
     WashService(std::string name, int durationMin, double price,
@@ -32,6 +45,11 @@ public:
     int needX() const noexcept { return needX_; }
     double rating() const noexcept { return rating_; }
 
+    /**
+     * @brief Counter bumped whenever price or rating change (lets caches detect stale data).
+     */
+    std::uint32_t revision() const noexcept { return revision_; }
+
     ServiceKind kind() const noexcept { return kind_; }
     bool isPremium() const noexcept { return kind_ == ServiceKind::Deluxe || kind_ == ServiceKind::Wax; }
 
@@ -39,6 +57,11 @@ public:
 
     virtual std::unique_ptr<WashService> clone() const = 0;
 
+    /**
+     * @brief Writes kind, name, timing, price, needs and rating; subclasses append their own state.
+     */
+    virtual void save(BinaryWriter &w) const;
+
     void applyFactor(double factor);
 
     static std::string kindToString(ServiceKind k);
@@ -20,5 +20,12 @@ public:
 
     bool nanoCoatingEnabled() const noexcept { return nanoCoatingEnabled_; }
 
+    void save(BinaryWriter &w) const override;
+
+    /**
+     * @brief Restores the nano coating flag and the pre-coating price/rating from a save.
+     */
+    void restoreCoating(bool enabled, double basePrice, double baseRating);
+
     std::unique_ptr<WashService> clone() const override;
 };
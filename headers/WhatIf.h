@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ReportHistory.h"
+#include "Statistics.h"
+
+/**
+ * @brief One candidate action evaluated by CarWash::whatIf().
+ *
+ * A branch first buys the upgrade (if upgradeId > 0), then switches the pricing mode
+ * (if pricing is not empty). An option with neither is the "do nothing" baseline.
+ */
+struct WhatIfOption {
+    std::string label;
+    int upgradeId{0};
+    std::string pricing;
+};
+
+/**
+ * @brief Projected outcome of one what-if branch.
+ */
+struct WhatIfBranch {
+    std::string label;
+    bool feasible{true}; /**< false if the action itself was rejected (see error). */
+    std::string error;
+    Statistics projected{ReportHistory{}}; /**< Only the days simulated inside the branch. */
+    double finalCash{0.0};
+};
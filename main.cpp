@@ -1,58 +1,404 @@
+#include <chrono>
+#include <cmath>
 #include <exception>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
 
+#include "headers/AchievementCatalog.h"
 #include "headers/CarWash.h"
 #include "headers/CarWashExceptions.h"
-#include "headers/Inventory.h"
-#include "headers/ServiceFactory.h"
-#include "headers/WashBay.h"
+#include "headers/CarWashNetwork.h"
+#include "headers/EventJournal.h"
+#include "headers/HistoryLog.h"
+#include "headers/MonteCarlo.h"
+#include "headers/Reductions.h"
+#include "headers/ReplayLog.h"
+#include "headers/ReportExporter.h"
+#include "headers/Scenario.h"
+#include "headers/ThreadPool.h"
 
-int main() {
-    try {
-        const int OPEN = 8 * 60;
-        const int CLOSE = 12 * 60;
+namespace {
+    /**
+     * @brief Command line options.
+     *
+     * Without --batch / --montecarlo / --network the interactive game starts as before.
+     */
+    struct CliOptions {
+        bool batch{false};
+        bool monteCarlo{false};
+        bool network{false};
+        int sites{10};
+        int days{1};
+        bool hasSeed{false};
+        unsigned seed{0};
+        int replicas{100};
+        int threads{0};
+        double startCash{0.0};
+        std::string pricing;
+        std::vector<int> upgrades;
+        int bays{0};
+        std::string checkpoint; /**< Batch: file rewritten after every simulated day (history in FILE.hist). */
+        std::string resume; /**< Batch: save file to continue from. */
+        std::string record; /**< Interactive: command log to write. */
+        std::string replay; /**< Command log to re-execute and verify. */
+        std::string journal; /**< Path prefix of the gameplay journal segments. */
+        int journalMb{64}; /**< Size of one journal segment in MiB. */
+        std::string exportPrefix; /**< Path prefix of the exported report tables. */
+        ExportFormat exportFormat{ExportFormat::Csv};
+        bool exportCustomers{false}; /**< Also export one row per served / lost customer. */
+        std::string achievements; /**< Achievement catalog replacing the built-in one. */
+    };
+
+    const char *const kUsage =
+            "Folosire: oop [--batch | --montecarlo --replicas R --threads T | --network --sites K --threads T]"
+            " --days N --seed S"
+            " [--cash C] [--pricing M] [--upgrade ID]... [--bays B]"
+            " [--checkpoint FISIER] [--resume FISIER] [--record FISIER | --replay FISIER]"
+            " [--journal PREFIX [--journal-mb MB]]"
+            " [--export PREFIX [--export-format csv|bin] [--export-customers]]"
+            " [--simd scalar|avx2] [--achievements FISIER]";
+
+    int parseInt(const std::string &flag, const char *value) {
+        if (!value) throw InvalidCommandException("Lipseste valoarea pentru " + flag);
+        const std::string text(value);
+        size_t pos = 0;
+        int v = 0;
+        try {
+            v = std::stoi(text, &pos);
+        } catch (const std::exception &) {
+            pos = 0;
+        }
+        if (pos == 0 || pos != text.size()) {
+            throw InvalidCommandException("Valoare invalida pentru " + flag + ": " + text);
+        }
+        return v;
+    }
+
+    /**
+     * @brief Parses a finite decimal number (e.g. --cash 150.5).
+     */
+    double parseDouble(const std::string &flag, const char *value) {
+        if (!value) throw InvalidCommandException("Lipseste valoarea pentru " + flag);
+        const std::string text(value);
+        size_t pos = 0;
+        double v = 0.0;
+        try {
+            v = std::stod(text, &pos);
+        } catch (const std::exception &) {
+            pos = 0;
+        }
+        if (pos == 0 || pos != text.size() || !std::isfinite(v)) {
+            throw InvalidCommandException("Valoare invalida pentru " + flag + ": " + text);
+        }
+        return v;
+    }
+
+    /**
+     * @brief Parses a seed: any unsigned 32-bit value (negative ints wrap, as before).
+     */
+    unsigned parseSeed(const std::string &flag, const char *value) {
+        if (!value) throw InvalidCommandException("Lipseste valoarea pentru " + flag);
+        const std::string text(value);
+        size_t pos = 0;
+        long long v = 0;
+        try {
+            v = std::stoll(text, &pos);
+        } catch (const std::exception &) {
+            pos = 0;
+        }
+        if (pos == 0 || pos != text.size() || v < std::numeric_limits<int>::min()
+            || v > std::numeric_limits<unsigned>::max()) {
+            throw InvalidCommandException("Valoare invalida pentru " + flag + ": " + text);
+        }
+        return static_cast<unsigned>(v);
+    }
+
+    CliOptions parseArgs(int argc, char **argv) {
+        CliOptions opt;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg(argv[i]);
+            const char *next = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (arg == "--batch") {
+                opt.batch = true;
+            } else if (arg == "--days") {
+                opt.days = parseInt(arg, next);
+                ++i;
+            } else if (arg == "--seed") {
+                opt.seed = parseSeed(arg, next);
+                opt.hasSeed = true;
+                ++i;
+            } else if (arg == "--montecarlo") {
+                opt.monteCarlo = true;
+            } else if (arg == "--network") {
+                opt.network = true;
+            } else if (arg == "--sites") {
+                opt.sites = parseInt(arg, next);
+                ++i;
+            } else if (arg == "--replicas") {
+                opt.replicas = parseInt(arg, next);
+                ++i;
+            } else if (arg == "--threads") {
+                opt.threads = parseInt(arg, next);
+                ++i;
+            } else if (arg == "--cash") {
+                opt.startCash = parseDouble(arg, next);
+                ++i;
+            } else if (arg == "--pricing") {
+                if (!next) throw InvalidCommandException("Lipseste valoarea pentru " + arg);
+                opt.pricing = next;
+                ++i;
+            } else if (arg == "--upgrade") {
+                opt.upgrades.push_back(parseInt(arg, next));
+                ++i;
+            } else if (arg == "--bays") {
+                opt.bays = parseInt(arg, next);
+                ++i;
+            } else if (arg == "--checkpoint" || arg == "--resume" || arg == "--record" || arg == "--replay"
+                       || arg == "--journal" || arg == "--export") {
+                if (!next) throw InvalidCommandException("Lipseste valoarea pentru " + arg);
+                if (arg == "--checkpoint") opt.checkpoint = next;
+                else if (arg == "--resume") opt.resume = next;
+                else if (arg == "--record") opt.record = next;
+                else if (arg == "--replay") opt.replay = next;
+                else if (arg == "--journal") opt.journal = next;
+                else opt.exportPrefix = next;
+                ++i;
+            } else if (arg == "--journal-mb") {
+                opt.journalMb = parseInt(arg, next);
+                ++i;
+            } else if (arg == "--export-format") {
+                const std::string fmt = next ? next : "";
+                if (fmt == "csv") opt.exportFormat = ExportFormat::Csv;
+                else if (fmt == "bin") opt.exportFormat = ExportFormat::Binary;
+                else throw InvalidCommandException("--export-format trebuie sa fie csv sau bin");
+                ++i;
+            } else if (arg == "--export-customers") {
+                opt.exportCustomers = true;
+            } else if (arg == "--simd") {
+                // checking against the scalar kernels: run once with "scalar", once with the default
+                const std::string level = next ? next : "";
+                if (level == "scalar") Reductions::setLevel(SimdLevel::Scalar);
+                else if (level == "avx2") {
+                    if (Reductions::supportedLevel() != SimdLevel::Avx2)
+                        throw InvalidCommandException("--simd avx2: procesorul nu suporta AVX2");
+                    Reductions::setLevel(SimdLevel::Avx2);
+                }
+                else throw InvalidCommandException("--simd trebuie sa fie scalar sau avx2");
+                ++i;
+            } else if (arg == "--achievements") {
+                if (!next) throw InvalidCommandException("Lipseste valoarea pentru " + arg);
+                opt.achievements = next;
+                ++i;
+            } else {
+                throw InvalidCommandException("Argument necunoscut: " + arg + ". " + kUsage);
+            }
+        }
+        if (opt.days <= 0) throw InvalidCommandException("--days trebuie sa fie > 0");
+        if (opt.replicas <= 0) throw InvalidCommandException("--replicas trebuie sa fie > 0");
+        if (opt.sites <= 0) throw InvalidCommandException("--sites trebuie sa fie > 0");
+        if (opt.journalMb <= 0) throw InvalidCommandException("--journal-mb trebuie sa fie > 0");
+        // only the interactive loop reads commands, so there is nothing to record otherwise
+        if (!opt.record.empty() && (opt.batch || opt.monteCarlo || opt.network)) {
+            throw InvalidCommandException("--record inregistreaza doar sesiuni interactive (fara --batch/--montecarlo/--network)");
+        }
+        return opt;
+    }
+
+    /**
+     * @brief Seed of a run: --seed if given, otherwise a fresh one (printed, so --seed can repeat the run).
+     */
+    std::uint64_t runSeed(const CliOptions &opt) {
+        return opt.hasSeed ? opt.seed : std::random_device{}();
+    }
+
+    /**
+     * @brief Runs N days headless and prints one Statistics summary plus throughput.
+     *
+     * With --resume the run continues from a save file; with --checkpoint the state is
+     * saved after every day, so an interrupted run can be resumed without losing more than a day.
+     * The report history of a checkpoint goes to an append-only log next to it (FILE.hist),
+     * so each daily checkpoint only writes the new day.
+     *
+     * @param seed Seed the game was started with (printed so the run can be repeated).
+     */
+    void runBatch(CarWash &game, const CliOptions &opt, std::uint64_t seed) {
+        if (!opt.resume.empty()) game.load(opt.resume);
 
-        Inventory inv(3000, 2000, 1500);
-        std::cout << "Initial inventory: " << inv << "\n";
+        const auto t0 = std::chrono::steady_clock::now();
+        if (opt.checkpoint.empty()) {
+            game.runDays(opt.days);
+        } else {
+            HistoryLog history(opt.checkpoint + HistoryLog::SUFFIX);
+            for (int d = 0; d < opt.days; ++d) {
+                game.runDays(1);
+                game.checkpoint(opt.checkpoint, history);
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double secs = std::chrono::duration<double>(t1 - t0).count();
+        std::cout << "=== BATCH ===\n";
+        std::cout << "Days: " << opt.days << " | Seed: ";
+        if (opt.resume.empty()) std::cout << seed;
+        else std::cout << "(din " << opt.resume << ")"; // generatorul vine din salvare
+        std::cout << "\n";
+        game.printSummary(std::cout);
+        std::cout << "Final cash: " << game.totalCash() << " EUR\n";
+        std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << secs << " s | Throughput: "
+                << std::setprecision(1) << (secs > 0.0 ? opt.days / secs : 0.0) << " days/s\n";
+    }
 
-        CarWash game("CarWash TYCOON", inv, OPEN, CLOSE);
+    /**
+     * @brief Re-executes a recorded session headless and checks that it ends in the recorded state.
+     *
+     * @return Process exit code (0 if the final state matches).
+     */
+    int runReplay(const CliOptions &opt) {
+        const ReplayLog log = ReplayLog::read(opt.replay);
 
-        auto basicDefault = ServiceFactory::create("basic");
-        auto basicCfg = ServiceFactory::createConfigured(
-            ServiceFactory::Kind::Basic, "Basic", 20, 8.0, 80, 40, 0);
+        const auto t0 = std::chrono::steady_clock::now();
+        const ReplayResult result = log.replay();
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double secs = std::chrono::duration<double>(t1 - t0).count();
+        std::cout << "=== REPLAY ===\n";
+        std::cout << "Seed: " << log.seed << " | Comenzi: " << result.executed << "/" << log.entries.size()
+                << " | Ziua finala: " << result.state->currentDay() << "\n";
+        std::cout << "Digest: " << std::hex << result.digest;
+        if (log.complete) std::cout << " (inregistrat " << log.finalDigest << ")";
+        std::cout << std::dec << "\n";
+        if (result.firstDesync >= 0) {
+            std::cout << "Desincronizare la comanda #" << result.firstDesync + 1 << ": "
+                    << log.entries[static_cast<size_t>(result.firstDesync)].command << "\n";
+        }
+        if (!log.complete) std::cout << "Rezultat: log incomplet (sesiunea nu s-a incheiat normal)\n";
+        else std::cout << "Rezultat: " << (result.verified ? "OK" : "DIVERGENT") << "\n";
+        std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << secs << " s\n";
+        return log.complete && !result.verified ? 1 : 0;
+    }
 
-        auto deluxeCfg = ServiceFactory::createConfigured(
-            ServiceFactory::Kind::Deluxe, "Deluxe", 35, 14.5, 120, 60, 0);
+    /**
+     * @brief Runs independent seeded replicas in parallel and prints the merged bands.
+     */
+    void runMonteCarlo(const Scenario &scenario, const CliOptions &opt) {
+        const std::uint64_t seed = runSeed(opt);
+        const MonteCarloRunner runner(scenario, opt.days, seed);
 
-        auto waxCfg = ServiceFactory::createConfigured(
-            ServiceFactory::Kind::Wax, "Wax", 25, 16.0, 60, 20, 50);
+        const auto t0 = std::chrono::steady_clock::now();
+        ThreadPool pool(opt.threads);
+        const auto results = runner.run(opt.replicas, pool);
+        const auto t1 = std::chrono::steady_clock::now();
 
-        auto ecoCfg = ServiceFactory::createConfigured(
-            ServiceFactory::Kind::Eco, "Eco", 30, 12.0, 50, 30, 0);
+        MonteCarloRunner::print(std::cout, MonteCarloRunner::summarize(results, opt.days, &pool));
+        std::cout << "Seed: " << seed << "\n";
+        const double secs = std::chrono::duration<double>(t1 - t0).count();
+        std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << secs << " s | Throughput: "
+                << std::setprecision(1) << (secs > 0.0 ? opt.replicas * static_cast<double>(opt.days) / secs : 0.0)
+                << " days/s\n";
+    }
+
+    /**
+     * @brief Simulates a chain of identical sites stepping in parallel and prints the chain summary.
+     */
+    void runNetwork(const Scenario &scenario, const CliOptions &opt) {
+        const std::uint64_t seed = runSeed(opt);
+        CarWashNetwork network(scenario, opt.sites, seed, opt.threads);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        network.runDays(opt.days);
+        const auto t1 = std::chrono::steady_clock::now();
+
+        std::cout << "=== RETEA ===\n";
+        std::cout << "Days: " << opt.days << " | Sites: " << opt.sites << " | Seed: " << seed << "\n";
+        network.printSummary(std::cout);
+        const double secs = std::chrono::duration<double>(t1 - t0).count();
+        std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << secs << " s | Throughput: "
+                << std::setprecision(1) << (secs > 0.0 ? opt.sites * static_cast<double>(opt.days) / secs : 0.0)
+                << " site-days/s\n";
+    }
+} // namespace
 
-        if (!basicDefault || !basicCfg || !deluxeCfg || !waxCfg || !ecoCfg) {
-            throw CarWashException("ServiceFactory a returnat nullptr");
+int main(int argc, char **argv) {
+    try {
+        const CliOptions opt = parseArgs(argc, argv);
+        // the catalog is process-wide, so it is only swapped once every argument is valid
+        if (!opt.achievements.empty()) AchievementCatalog::setActive(AchievementCatalog::fromFile(opt.achievements));
+        if (!opt.replay.empty()) return runReplay(opt);
+
+        Scenario scenario = Scenario::makeDefault();
+        scenario.setStartCash(opt.startCash);
+        if (!opt.pricing.empty()) scenario.setPricingMode(opt.pricing);
+        for (int id: opt.upgrades) scenario.addUpgrade(id);
+        for (int id = scenario.bayCount() + 1; id <= opt.bays; ++id) {
+            scenario.addBay(WashBay(id, scenario.openMin(), "B" + std::to_string(id)));
+        }
+
+        if (opt.monteCarlo) {
+            runMonteCarlo(scenario, opt);
+            return 0;
+        }
+        if (opt.network) {
+            runNetwork(scenario, opt);
+            return 0;
         }
 
-        game.addService(*basicDefault);
-        game.addService(*basicCfg);
-        game.addService(*deluxeCfg);
-        game.addService(*waxCfg);
-        game.addService(*ecoCfg);
+        if (!opt.batch) std::cout << "Initial inventory: " << scenario.inventory() << "\n";
 
-        WashBay b1(1, OPEN, "B1");
-        WashBay b2(2, OPEN + 10, "B2");
-        WashBay b3(3, OPEN + 5, "B3");
+        auto gamePtr = scenario.build(opt.batch ? nullptr : &std::cout);
+        CarWash &game = *gamePtr;
+        if (opt.hasSeed) game.seed(opt.seed);
 
-        game.addBay(b1);
-        game.addBay(b2);
-        game.addBay(b3);
+        std::unique_ptr<EventJournal> journal;
+        if (!opt.journal.empty()) {
+            journal = std::make_unique<EventJournal>(opt.journal, static_cast<std::size_t>(opt.journalMb) << 20);
+            game.setJournal(journal.get());
+        }
+        std::unique_ptr<ReportExporter> exporter;
+        if (!opt.exportPrefix.empty()) {
+            exporter = std::make_unique<ReportExporter>(opt.exportPrefix, opt.exportFormat, opt.exportCustomers);
+            game.setExporter(exporter.get());
+        }
+
+        if (opt.batch) {
+            const std::uint64_t seed = runSeed(opt);
+            game.seed(seed);
+            runBatch(game, opt, seed);
+            if (journal) {
+                std::cout << "Journal: " << journal->recordsWritten() << " records in "
+                        << journal->segments() << " segment(s)\n";
+            }
+            if (exporter) {
+                exporter->finish();
+                std::cout << "Export: " << exporter->daysExported() << " days, "
+                        << exporter->customersExported() << " customers\n";
+            }
+            return 0;
+        }
 
 #ifdef GITHUB_ACTIONS
         game.run();
+        if (exporter) exporter->finish();
         return 0;
 #else
+        if (opt.record.empty()) {
+            game.run();
+            if (exporter) exporter->finish();
+            return 0;
+        }
+        // the seed must be known to reproduce the session, so pick one explicitly
+        const std::uint64_t seed = runSeed(opt);
+        game.seed(seed);
+        ReplayRecorder recorder(opt.record, seed, game);
+        game.setRecorder(&recorder);
         game.run();
+        game.setRecorder(nullptr);
+        recorder.finish(game);
+        if (exporter) exporter->finish();
         return 0;
 #endif
     } catch (const CarWashException &ex) {
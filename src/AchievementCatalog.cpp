@@ -0,0 +1,340 @@
+#include "../headers/AchievementCatalog.h"
+#include "../headers/CarWashExceptions.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+/**
+ * @file AchievementCatalog.cpp
+ * @brief Parsing of achievements.def, the embedded copy of it and the active catalog.
+ */
+
+namespace {
+#ifdef EMBED_ACHIEVEMENTS
+#define ACHIEVEMENT(id, name, desc, category, rarity, kind, metric, threshold, cash, demand, speed, comfort, hidden) \
+    AchievementDef{#id, name, desc, AchievementCategory::category, AchievementRarity::rarity,                          \
+                   AchievementKind::kind, AchievementMetric::metric, threshold,                                        \
+                   AchievementReward{cash, demand, speed, comfort}, hidden},
+
+    constexpr AchievementDef kEmbedded[] = {
+#include "../achievements.def"
+    };
+
+#undef ACHIEVEMENT
+#endif
+
+    template<typename E, size_t N>
+    using Names = std::array<std::pair<std::string_view, E>, N>;
+
+    constexpr Names<AchievementCategory, 5> kCategories{{
+        {"Operations", AchievementCategory::Operations},
+        {"Finance", AchievementCategory::Finance},
+        {"Reputation", AchievementCategory::Reputation},
+        {"Management", AchievementCategory::Management},
+        {"Hidden", AchievementCategory::Hidden},
+    }};
+
+    constexpr Names<AchievementRarity, 4> kRarities{{
+        {"Common", AchievementRarity::Common},
+        {"Rare", AchievementRarity::Rare},
+        {"Epic", AchievementRarity::Epic},
+        {"Legendary", AchievementRarity::Legendary},
+    }};
+
+    constexpr Names<AchievementKind, 4> kKinds{{
+        {"Threshold", AchievementKind::Threshold},
+        {"PerfectDay", AchievementKind::PerfectDay},
+        {"RevenueDay", AchievementKind::RevenueDay},
+        {"AvgSatDay", AchievementKind::AvgSatDay},
+    }};
+
+    constexpr Names<AchievementMetric, 9> kMetrics{{
+        {"CarsServedTotal", AchievementMetric::CarsServedTotal},
+        {"CashTotal", AchievementMetric::CashTotal},
+        {"ReputationScore", AchievementMetric::ReputationScore},
+        {"BaysCount", AchievementMetric::BaysCount},
+        {"ServicesCount", AchievementMetric::ServicesCount},
+        {"UpgradesBought", AchievementMetric::UpgradesBought},
+        {"SuppliesPacks", AchievementMetric::SuppliesPacks},
+        {"PerfectDays", AchievementMetric::PerfectDays},
+        {"None", AchievementMetric::None},
+    }};
+
+    constexpr size_t FIELDS = 13;
+
+    /**
+     * @brief Definition with its strings still in temporary storage (before the buffer is built).
+     */
+    struct RawDef {
+        std::string id, name, desc;
+        AchievementDef def;
+    };
+
+    /**
+     * @brief Parser for one source; reports errors with the file name and line.
+     */
+    class RowParser {
+        const std::string &source_;
+        int line_;
+
+    public:
+        RowParser(const std::string &source, int line) : source_(source), line_(line) {
+        }
+
+        [[noreturn]] void fail(const std::string &what) const {
+            throw CatalogException(source_ + ":" + std::to_string(line_) + ": " + what);
+        }
+
+        /**
+         * @brief Splits the argument list of ACHIEVEMENT(...) at top-level commas; strings keep their quotes.
+         */
+        std::vector<std::string_view> split(std::string_view args) const {
+            std::vector<std::string_view> out;
+            size_t start = 0;
+            bool quoted = false;
+            for (size_t i = 0; i < args.size(); ++i) {
+                const char c = args[i];
+                if (quoted) {
+                    if (c == '\\') ++i;
+                    else if (c == '"') quoted = false;
+                } else if (c == '"') {
+                    quoted = true;
+                } else if (c == ',') {
+                    out.push_back(trim(args.substr(start, i - start)));
+                    start = i + 1;
+                }
+            }
+            if (quoted) fail("ghilimele neinchise");
+            out.push_back(trim(args.substr(start)));
+            return out;
+        }
+
+        static std::string_view trim(std::string_view s) {
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+            return s;
+        }
+
+        std::string identifier(std::string_view s) const {
+            if (s.empty()) fail("id gol");
+            for (char c: s) {
+                if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') fail("id invalid: " + std::string(s));
+            }
+            return std::string(s);
+        }
+
+        std::string text(std::string_view s) const {
+            if (s.size() < 2 || s.front() != '"' || s.back() != '"') fail("se astepta un text intre ghilimele: " + std::string(s));
+            std::string out;
+            for (size_t i = 1; i + 1 < s.size(); ++i) {
+                if (s[i] == '\\' && i + 2 < s.size()) ++i;
+                out += s[i];
+            }
+            return out;
+        }
+
+        template<typename E, size_t N>
+        E lookup(const Names<E, N> &names, std::string_view s, const char *what) const {
+            for (const auto &[name, value]: names) {
+                if (name == s) return value;
+            }
+            fail("valoare necunoscuta pentru " + std::string(what) + ": " + std::string(s));
+        }
+
+        template<typename T>
+        T number(std::string_view s) const {
+            T v{};
+            const auto res = std::from_chars(s.data(), s.data() + s.size(), v);
+            if (res.ec != std::errc{} || res.ptr != s.data() + s.size()) fail("numar invalid: " + std::string(s));
+            return v;
+        }
+
+        bool boolean(std::string_view s) const {
+            if (s == "true") return true;
+            if (s == "false") return false;
+            fail("se astepta true sau false: " + std::string(s));
+        }
+
+        RawDef row(std::string_view args) const {
+            const auto f = split(args);
+            if (f.size() != FIELDS) {
+                fail("se asteptau " + std::to_string(FIELDS) + " campuri, nu " + std::to_string(f.size()));
+            }
+            RawDef r;
+            r.id = identifier(f[0]);
+            r.name = text(f[1]);
+            r.desc = text(f[2]);
+            AchievementDef &d = r.def;
+            d.category = lookup(kCategories, f[3], "categorie");
+            d.rarity = lookup(kRarities, f[4], "raritate");
+            d.kind = lookup(kKinds, f[5], "tip");
+            d.metric = lookup(kMetrics, f[6], "metrica");
+            d.threshold = number<double>(f[7]);
+            d.reward.cash = number<double>(f[8]);
+            d.reward.demand = number<int>(f[9]);
+            d.reward.speed = number<double>(f[10]);
+            d.reward.comfort = number<double>(f[11]);
+            d.hidden = boolean(f[12]);
+
+            if ((d.kind == AchievementKind::Threshold) == (d.metric == AchievementMetric::None)) {
+                fail("metrica se da doar (si obligatoriu) pentru tipul Threshold");
+            }
+            return r;
+        }
+    };
+
+    /**
+     * @brief Catalog installed by setActive(), if any.
+     */
+    std::shared_ptr<const AchievementCatalog> &replacement() {
+        static std::shared_ptr<const AchievementCatalog> catalog;
+        return catalog;
+    }
+} // namespace
+
+/**
+ * @brief Parses every ACHIEVEMENT(...) row; blank lines and // comments are skipped.
+ *
+ * Rows are first parsed with their own strings, then all strings are copied into one
+ * buffer that the final string_views point into.
+ */
+AchievementCatalog AchievementCatalog::parse(std::string_view text, const std::string &source) {
+    std::vector<RawDef> rows;
+    int lineNo = 0;
+    while (!text.empty()) {
+        const size_t eol = text.find('\n');
+        std::string_view line = RowParser::trim(text.substr(0, eol));
+        text = eol == std::string_view::npos ? std::string_view{} : text.substr(eol + 1);
+        ++lineNo;
+        if (line.empty() || line.starts_with("//")) continue;
+
+        const RowParser p(source, lineNo);
+        constexpr std::string_view open = "ACHIEVEMENT(";
+        if (!line.starts_with(open) || !line.ends_with(")")) p.fail("se astepta ACHIEVEMENT(...)");
+        RawDef r = p.row(line.substr(open.size(), line.size() - open.size() - 1));
+        for (const RawDef &other: rows) {
+            if (other.id == r.id) p.fail("id duplicat: " + r.id);
+        }
+        rows.push_back(std::move(r));
+    }
+
+    size_t bytes = 0;
+    for (const RawDef &r: rows) bytes += r.id.size() + r.name.size() + r.desc.size();
+
+    AchievementCatalog c;
+    c.text_ = std::make_unique<char[]>(bytes > 0 ? bytes : 1);
+    c.owned_.reserve(rows.size());
+    char *out = c.text_.get();
+    const auto keep = [&out](const std::string &s) {
+        std::memcpy(out, s.data(), s.size());
+        const std::string_view view(out, s.size());
+        out += s.size();
+        return view;
+    };
+    for (const RawDef &r: rows) {
+        AchievementDef d = r.def;
+        d.id = keep(r.id);
+        d.name = keep(r.name);
+        d.desc = keep(r.desc);
+        c.owned_.push_back(d);
+    }
+    c.defs_ = c.owned_;
+    c.buildIndex();
+    return c;
+}
+
+AchievementCatalog AchievementCatalog::fromFile(const std::string &path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) throw CatalogException("Nu se poate deschide catalogul de achievement-uri: " + path);
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return parse(ss.str(), path);
+}
+
+AchievementCatalog AchievementCatalog::embedded() {
+    AchievementCatalog c;
+#ifdef EMBED_ACHIEVEMENTS
+    c.defs_ = kEmbedded;
+#endif
+    c.buildIndex();
+    return c;
+}
+
+std::uint32_t AchievementCatalog::eventsOf(const AchievementDef &def) noexcept {
+    if (def.kind != AchievementKind::Threshold) return eventBit(AchievementEventType::DayEnd);
+    switch (def.metric) {
+        case AchievementMetric::CarsServedTotal: return eventBit(AchievementEventType::Served);
+        case AchievementMetric::UpgradesBought: return eventBit(AchievementEventType::BuyUpgrade);
+        case AchievementMetric::SuppliesPacks: return eventBit(AchievementEventType::BuySupplies);
+        case AchievementMetric::PerfectDays: return eventBit(AchievementEventType::DayEnd);
+        case AchievementMetric::CashTotal:
+        case AchievementMetric::ReputationScore:
+        case AchievementMetric::BaysCount:
+        case AchievementMetric::ServicesCount:
+        case AchievementMetric::None: break;
+    }
+    return ALL_ACHIEVEMENT_EVENTS;
+}
+
+/**
+ * @brief Groups the definitions into slots and builds the id lookup.
+ */
+void AchievementCatalog::buildIndex() {
+    slots_.clear();
+    slotOf_.assign(defs_.size(), 0);
+    byId_.clear();
+
+    std::vector<std::pair<AchievementMetric, std::uint32_t> > ladders; // metric -> slot
+    for (size_t i = 0; i < defs_.size(); ++i) {
+        const AchievementDef &d = defs_[i];
+        auto slot = static_cast<std::uint32_t>(slots_.size());
+        if (d.kind == AchievementKind::Threshold) {
+            for (const auto &[metric, s]: ladders) {
+                if (metric == d.metric) slot = s;
+            }
+            if (slot == slots_.size()) ladders.emplace_back(d.metric, slot);
+        }
+        if (slot == slots_.size()) slots_.emplace_back();
+        slots_[slot].rungs.push_back(static_cast<std::uint32_t>(i));
+        slots_[slot].events |= eventsOf(d);
+        slotOf_[i] = slot;
+        byId_.emplace_back(d.id, static_cast<std::uint32_t>(i));
+    }
+    for (Slot &slot: slots_) {
+        std::stable_sort(slot.rungs.begin(), slot.rungs.end(), [this](std::uint32_t a, std::uint32_t b) {
+            return defs_[a].threshold < defs_[b].threshold;
+        });
+    }
+    std::sort(byId_.begin(), byId_.end());
+}
+
+int AchievementCatalog::find(std::string_view id) const noexcept {
+    const auto it = std::lower_bound(byId_.begin(), byId_.end(), id,
+                                     [](const auto &entry, std::string_view key) { return entry.first < key; });
+    return it != byId_.end() && it->first == id ? static_cast<int>(it->second) : -1;
+}
+
+bool AchievementCatalog::hasEmbedded() noexcept {
+#ifdef EMBED_ACHIEVEMENTS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<const AchievementCatalog> AchievementCatalog::active() {
+    if (const auto &r = replacement()) return r;
+    static const auto builtin = std::make_shared<const AchievementCatalog>(
+        hasEmbedded() ? embedded() : fromFile(DEFAULT_FILE));
+    return builtin;
+}
+
+void AchievementCatalog::setActive(AchievementCatalog catalog) {
+    replacement() = std::make_shared<const AchievementCatalog>(std::move(catalog));
+}
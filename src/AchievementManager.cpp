@@ -1,12 +1,16 @@
 #include "../headers/AchievementManager.h"
+#include "../headers/AchievementCatalog.h"
 #include "../headers/CarWash.h"
+#include "../headers/BinaryIO.h"
 
 #include <algorithm>
-#include <iomanip>
+#include <bit>
+#include <string_view>
+#include <utility>
 
 /**
  * @file AchievementManager.cpp
- * @brief Implements the achievement system: printing, dispatching events and unlocking rewards.
+ * @brief Implements the per-game achievement state: dispatching events, unlocking rewards and printing.
  */
 
 namespace {
@@ -16,7 +20,7 @@ namespace {
      * @param r Rarity enum value.
      * @return String representation of the rarity.
      */
-    static std::string rarityToStr(AchievementRarity r) {
+    std::string rarityToStr(AchievementRarity r) {
         switch (r) {
             case AchievementRarity::Common: return "Common";
             case AchievementRarity::Rare: return "Rare";
@@ -32,7 +36,7 @@ namespace {
      * @param c Category enum value.
      * @return String representation of the category.
      */
-    static std::string catToStr(AchievementCategory c) {
+    std::string catToStr(AchievementCategory c) {
         switch (c) {
             case AchievementCategory::Operations: return "Operations";
             case AchievementCategory::Finance: return "Finance";
@@ -42,373 +46,292 @@ namespace {
         }
         return "Operations";
     }
+
+    /**
+     * @brief Current value of the metric watched by a threshold definition.
+     */
+    int metricValue(const CarWash &game, AchievementMetric metric) {
+        switch (metric) {
+            case AchievementMetric::CarsServedTotal: return game.totalCarsServed();
+            case AchievementMetric::CashTotal: return static_cast<int>(game.totalCash());
+            case AchievementMetric::ReputationScore: return static_cast<int>(game.reputationScore() * 100.0);
+            case AchievementMetric::BaysCount: return game.bayCount();
+            case AchievementMetric::ServicesCount: return game.serviceCount();
+            case AchievementMetric::UpgradesBought: return game.upgradesBought();
+            case AchievementMetric::SuppliesPacks: return game.suppliesPacksBought();
+            case AchievementMetric::PerfectDays: return game.perfectDaysCount();
+            case AchievementMetric::None: break;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Progress needed to unlock: the threshold for metrics, 1 for day-end kinds.
+     */
+    int targetOf(const AchievementDef &d) {
+        return d.kind == AchievementKind::Threshold ? static_cast<int>(d.threshold) : 1;
+    }
+
+    size_t words(size_t bits) { return (bits + 63) / 64; }
+
+    /**
+     * @brief Cash headroom below which the exact check runs (metricValue truncates the cash).
+     */
+    constexpr double CASH_SLACK = 1.0;
 } // namespace
 
+AchievementManager::AchievementManager() : AchievementManager(AchievementCatalog::active()) {
+}
+
 /**
- * @brief Unlocks an achievement once and applies its reward to the game.
- *
- * Rewards are applied by calling CarWash mutators:
- * - cash boost
- * - demand boost
- * - speed factor increase
- * - comfort bonus increase
- *
- * @param game Game instance to mutate when applying the reward.
+ * @brief Starts with every definition of the catalog locked and at zero progress.
  */
-void Achievement::unlock(CarWash &game) {
-    if (unlocked_) return;
-    unlocked_ = true;
-
-    if (reward_.cash != 0.0) game.adjustCash(reward_.cash);
-    if (reward_.demand != 0) game.increaseBaseDemand(reward_.demand);
-    if (reward_.speed != 0.0) game.increaseSpeedFactor(reward_.speed);
-    if (reward_.comfort != 0.0) game.increaseComfortBonus(reward_.comfort);
+AchievementManager::AchievementManager(std::shared_ptr<const AchievementCatalog> catalog)
+    : catalog_(std::move(catalog)),
+      unlocked_(words(catalog_->size()), 0),
+      progress_(catalog_->size(), 0) {
+    buildIndex();
+}
 
-    game.logEvent("ACHIEVEMENT UNLOCKED: " + name_);
+bool AchievementManager::slotDone(size_t s) const noexcept {
+    return active_[s] >= catalog_->slots()[s].rungs.size();
 }
 
 /**
- * @brief Prints a single achievement in a compact console-friendly format.
- *
- * Uses displayName()/displayDesc() to respect hidden achievements (masked until unlocked).
- *
- * @param os Output stream.
+ * @brief Moves every ladder to its lowest locked rung and lists the unfinished slots.
  */
-void Achievement::print(std::ostream &os) const {
-    os << (unlocked_ ? "[UNLOCKED] " : "[LOCKED] ");
-    os << displayName() << " | " << displayDesc();
-    os << " | " << catToStr(category()) << " | " << rarityToStr(rarity());
-    os << " | hidden=" << (hidden() ? "1" : "0");
-    os << " | " << progress() << "/" << target();
+void AchievementManager::buildIndex() {
+    const auto &slots = catalog_->slots();
+    active_.assign(slots.size(), 0);
+    for (auto &bits: live_) bits.assign(words(slots.size()), 0);
+
+    for (size_t s = 0; s < slots.size(); ++s) {
+        const auto &rungs = slots[s].rungs;
+        while (!slotDone(s) && isUnlocked(rungs[active_[s]])) ++active_[s];
+        if (slotDone(s)) continue;
+        for (size_t t = 0; t < ACHIEVEMENT_EVENT_TYPES; ++t) {
+            if (slots[s].events & eventBit(static_cast<AchievementEventType>(t))) {
+                live_[t][s / 64] |= std::uint64_t{1} << (s % 64);
+            }
+        }
+    }
 }
 
 /**
- * @brief Stream operator for Achievement.
+ * @brief Evaluates one definition against the current game state and the event.
  *
- * @param os Output stream.
- * @param a Achievement instance.
- * @return Output stream.
+ * Threshold definitions re-read their metric and keep progress at min(value, threshold);
+ * day-end kinds only react to DayEnd events and keep 1 / 0 for the last day.
  */
-std::ostream &operator<<(std::ostream &os, const Achievement &a) {
-    a.print(os);
-    return os;
+void AchievementManager::check(size_t i, CarWash &game, const AchievementEvent &ev) {
+    const AchievementDef &d = catalog_->def(i);
+    bool ok = false;
+    switch (d.kind) {
+        case AchievementKind::Threshold: {
+            const int threshold = static_cast<int>(d.threshold);
+            const int value = metricValue(game, d.metric);
+            progress_[i] = std::min(value, threshold);
+            ok = value >= threshold;
+            break;
+        }
+        case AchievementKind::PerfectDay:
+        case AchievementKind::RevenueDay:
+        case AchievementKind::AvgSatDay:
+            if (ev.type != AchievementEventType::DayEnd) return;
+            if (d.kind == AchievementKind::PerfectDay) {
+                ok = ev.dailyLost == 0 && ev.dailyServed >= static_cast<int>(d.threshold);
+            } else if (d.kind == AchievementKind::RevenueDay) {
+                ok = ev.dailyRevenue >= d.threshold;
+            } else {
+                ok = ev.dailyServed > 0 && ev.dailyAvgSat >= d.threshold;
+            }
+            progress_[i] = ok ? 1 : 0;
+            break;
+    }
+    if (ok) unlock(i, game);
 }
 
-namespace {
-    /**
-     * @brief Generic threshold-based achievement.
-     *
-     * The achievement unlocks when a chosen game metric reaches a specified threshold.
-     * It updates progress to min(currentValue, threshold).
-     */
-    struct ThresholdAch final : Achievement {
-        /**
-         * @brief Enumerates supported game metrics used by threshold achievements.
-         */
-        enum class Metric {
-            CarsServedTotal,
-            CashTotal,
-            ReputationScore,
-            BaysCount,
-            ServicesCount,
-            UpgradesBought,
-            SuppliesPacks,
-            PerfectDays
-        };
+bool AchievementManager::couldUnlock(size_t i, const CarWash &game) const {
+    const AchievementDef &d = catalog_->def(i);
+    if (d.kind != AchievementKind::Threshold) return true;
+    return metricValue(game, d.metric) >= static_cast<int>(d.threshold);
+}
 
-        Metric metric_;
-        int threshold_{1};
-
-        /**
-         * @brief Constructs a threshold achievement.
-         *
-         * @param id Stable identifier.
-         * @param name Display name.
-         * @param desc Display description.
-         * @param cat Category.
-         * @param rar Rarity.
-         * @param m Metric to track.
-         * @param threshold Unlock threshold.
-         * @param reward Reward applied upon unlock.
-         * @param hidden Whether the achievement is hidden until unlocked.
-         */
-        ThresholdAch(std::string id, std::string name, std::string desc,
-                     AchievementCategory cat, AchievementRarity rar,
-                     Metric m, int threshold, const AchievementReward &reward, bool hidden = false)
-            : Achievement(std::move(id), std::move(name), std::move(desc), cat, rar, threshold, reward, hidden),
-              metric_(m),
-              threshold_(threshold) {
-        }
+/**
+ * @brief Unlocks a definition once and applies its reward to the game.
+ *
+ * Rewards are applied by calling CarWash mutators:
+ * - cash boost
+ * - demand boost
+ * - speed factor increase
+ * - comfort bonus increase
+ *
+ * @param i Definition index.
+ * @param game Game instance to mutate when applying the reward.
+ */
+void AchievementManager::unlock(size_t i, CarWash &game) {
+    if (isUnlocked(i)) return;
+    unlocked_[i / 64] |= std::uint64_t{1} << (i % 64);
 
-        /**
-         * @brief Updates progress based on the current metric value and unlocks if threshold is met.
-         *
-         * @param game Game state used to read metrics and apply rewards on unlock.
-         * @param ev Event payload (not used directly; this achievement re-checks current game metrics).
-         */
-        void onEvent(CarWash &game, const AchievementEvent &) override {
-            if (unlocked_) return;
-
-            int value = 0;
-            switch (metric_) {
-                case Metric::CarsServedTotal: value = game.totalCarsServed();
-                    break;
-                case Metric::CashTotal: value = static_cast<int>(game.totalCash());
-                    break;
-                case Metric::ReputationScore: value = static_cast<int>(game.reputationScore() * 100.0);
-                    break;
-                case Metric::BaysCount: value = game.bayCount();
-                    break;
-                case Metric::ServicesCount: value = game.serviceCount();
-                    break;
-                case Metric::UpgradesBought: value = game.upgradesBought();
-                    break;
-                case Metric::SuppliesPacks: value = game.suppliesPacksBought();
-                    break;
-                case Metric::PerfectDays: value = game.perfectDaysCount();
-                    break;
-            }
+    const AchievementDef &d = catalog_->def(i);
+    if (d.reward.cash != 0.0) game.adjustCash(d.reward.cash);
+    if (d.reward.demand != 0) game.increaseBaseDemand(d.reward.demand);
+    if (d.reward.speed != 0.0) game.increaseSpeedFactor(d.reward.speed);
+    if (d.reward.comfort != 0.0) game.increaseComfortBonus(d.reward.comfort);
 
-            progress_ = std::min(value, threshold_);
-            if (value >= threshold_) unlock(game);
-        }
-    };
+    game.logEvent("ACHIEVEMENT UNLOCKED: " + std::string(d.name));
+}
 
-    /**
-     * @brief Achievement unlocked by ending a day with no lost customers and a minimum served count.
-     */
-    struct PerfectDayAch final : Achievement {
-        int minServed_{0};
-
-        /**
-         * @brief Constructs a perfect-day achievement.
-         *
-         * @param id Stable identifier.
-         * @param name Display name.
-         * @param desc Display description.
-         * @param cat Category.
-         * @param rar Rarity.
-         * @param minServed Minimum cars served that day.
-         * @param reward Reward applied on unlock.
-         */
-        PerfectDayAch(std::string id, std::string name, std::string desc,
-                      AchievementCategory cat, AchievementRarity rar,
-                      int minServed, const AchievementReward &reward)
-            : Achievement(std::move(id), std::move(name), std::move(desc), cat, rar, 1, reward, false),
-              minServed_(minServed) {
+void AchievementManager::evaluate(size_t slot, CarWash &game, const AchievementEvent &ev) {
+    const auto &rungs = catalog_->slots()[slot].rungs;
+    while (!slotDone(slot)) {
+        const size_t i = rungs[active_[slot]];
+        if (!isUnlocked(i)) {
+            check(i, game, ev);
+            if (!isUnlocked(i)) return;
         }
+        ++active_[slot];
+    }
+}
 
-        /**
-         * @brief Checks DayEnd events and unlocks if day meets conditions.
-         *
-         * @param game Game state used to apply rewards.
-         * @param ev Event payload.
-         */
-        void onEvent(CarWash &game, const AchievementEvent &ev) override {
-            if (unlocked_) return;
-            if (ev.type != AchievementEventType::DayEnd) return;
+int AchievementManager::shownProgress(size_t i) const {
+    const size_t s = catalog_->slotOf(i);
+    if (slotDone(s) || isUnlocked(i)) return progress_[i];
+    const auto &rungs = catalog_->slots()[s].rungs;
+    const size_t active = rungs[active_[s]];
+    if (active == i) return progress_[i];
+    for (size_t r = active_[s] + 1u; r < rungs.size(); ++r) {
+        if (rungs[r] == i) return std::min(progress_[active], targetOf(catalog_->def(i)));
+    }
+    return progress_[i];
+}
 
-            const bool ok = (ev.dailyLost == 0 && ev.dailyServed >= minServed_);
-            progress_ = ok ? 1 : 0;
-            if (ok) unlock(game);
-        }
-    };
+/**
+ * @brief Dispatches a gameplay event to the achievements subscribed to its type.
+ *
+ * Live slots are visited in catalog order, so rewards of earlier unlocks are visible to
+ * later checks of the same event, as with a full scan. Slots that finish are dropped from
+ * every live bitset. Coalesced outcomes still pending are dispatched first.
+ *
+ * @param game Game state used to read metrics and apply rewards.
+ * @param ev Event payload describing the gameplay occurrence.
+ */
+void AchievementManager::dispatch(CarWash &game, const AchievementEvent &ev) {
+    flushPending(game);
+    route(game, ev);
+    if (coalescing_) armHeadroom(game);
+}
 
-    /**
-     * @brief Achievement unlocked by reaching a minimum revenue at day end.
-     */
-    struct RevenueDayAch final : Achievement {
-        double minRevenue_{0.0};
-
-        /**
-         * @brief Constructs a revenue-per-day achievement.
-         *
-         * @param id Stable identifier.
-         * @param name Display name.
-         * @param desc Display description.
-         * @param cat Category.
-         * @param rar Rarity.
-         * @param minRevenue Minimum daily revenue required.
-         * @param reward Reward applied on unlock.
-         * @param hidden Whether the achievement is hidden until unlocked.
-         */
-        RevenueDayAch(std::string id, std::string name, std::string desc,
-                      AchievementCategory cat, AchievementRarity rar,
-                      double minRevenue, const AchievementReward &reward, bool hidden = false)
-            : Achievement(std::move(id), std::move(name), std::move(desc), cat, rar, 1, reward, hidden),
-              minRevenue_(minRevenue) {
+void AchievementManager::route(CarWash &game, const AchievementEvent &ev) {
+    const auto &bits = live_[static_cast<size_t>(ev.type)];
+    for (size_t w = 0; w < bits.size(); ++w) {
+        for (std::uint64_t word = bits[w]; word != 0; word &= word - 1) {
+            const size_t s = w * 64 + static_cast<size_t>(std::countr_zero(word));
+            evaluate(s, game, ev);
+            if (!slotDone(s)) continue;
+            for (auto &other: live_) other[w] &= ~(std::uint64_t{1} << (s % 64));
         }
+    }
+}
 
-        /**
-         * @brief Checks DayEnd events and unlocks when daily revenue is high enough.
-         *
-         * @param game Game state used to apply rewards.
-         * @param ev Event payload.
-         */
-        void onEvent(CarWash &game, const AchievementEvent &ev) override {
-            if (unlocked_) return;
-            if (ev.type != AchievementEventType::DayEnd) return;
-
-            const bool ok = (ev.dailyRevenue >= minRevenue_);
-            progress_ = ok ? 1 : 0;
-            if (ok) unlock(game);
+bool AchievementManager::anyDue(const CarWash &game, AchievementEventType type) const {
+    const auto &bits = live_[static_cast<size_t>(type)];
+    for (size_t w = 0; w < bits.size(); ++w) {
+        for (std::uint64_t word = bits[w]; word != 0; word &= word - 1) {
+            const size_t s = w * 64 + static_cast<size_t>(std::countr_zero(word));
+            if (couldUnlock(catalog_->slots()[s].rungs[active_[s]], game)) return true;
         }
-    };
+    }
+    return false;
+}
 
-    /**
-     * @brief Achievement unlocked by reaching a minimum average satisfaction at day end.
-     */
-    struct AvgSatDayAch final : Achievement {
-        double minAvg_{0.0};
-
-        /**
-         * @brief Constructs an average-satisfaction-per-day achievement.
-         *
-         * @param id Stable identifier.
-         * @param name Display name.
-         * @param desc Display description.
-         * @param cat Category.
-         * @param rar Rarity.
-         * @param minAvg Minimum average satisfaction required.
-         * @param reward Reward applied on unlock.
-         * @param hidden Whether the achievement is hidden until unlocked.
-         */
-        AvgSatDayAch(std::string id, std::string name, std::string desc,
-                     AchievementCategory cat, AchievementRarity rar,
-                     double minAvg, const AchievementReward &reward, bool hidden = false)
-            : Achievement(std::move(id), std::move(name), std::move(desc), cat, rar, 1, reward, hidden),
-              minAvg_(minAvg) {
+void AchievementManager::armHeadroom(const CarWash &game) {
+    headroom_ = Headroom{};
+    const auto &served = live_[static_cast<size_t>(AchievementEventType::Served)];
+    const auto &lost = live_[static_cast<size_t>(AchievementEventType::Lost)];
+    for (size_t w = 0; w < served.size(); ++w) {
+        for (std::uint64_t word = served[w] | lost[w]; word != 0; word &= word - 1) {
+            const size_t s = w * 64 + static_cast<size_t>(std::countr_zero(word));
+            const std::uint64_t bit = std::uint64_t{1} << (s % 64);
+            const size_t i = catalog_->slots()[s].rungs[active_[s]];
+            if (couldUnlock(i, game)) {
+                headroom_.served |= (served[w] & bit) != 0;
+                headroom_.lost |= (lost[w] & bit) != 0;
+                continue;
+            }
+            const AchievementDef &d = catalog_->def(i);
+            const int threshold = static_cast<int>(d.threshold);
+            if (d.metric == AchievementMetric::CarsServedTotal) {
+                headroom_.cars = std::min(headroom_.cars, threshold - game.totalCarsServed());
+            } else if (d.metric == AchievementMetric::CashTotal) {
+                headroom_.cash = std::min(headroom_.cash, threshold - game.totalCash());
+            }
         }
+    }
+}
 
-        /**
-         * @brief Checks DayEnd events and unlocks when daily average satisfaction is high enough.
-         *
-         * @param game Game state used to apply rewards.
-         * @param ev Event payload.
-         */
-        void onEvent(CarWash &game, const AchievementEvent &ev) override {
-            if (unlocked_) return;
-            if (ev.type != AchievementEventType::DayEnd) return;
-
-            const bool ok = (ev.dailyServed > 0 && ev.dailyAvgSat >= minAvg_);
-            progress_ = ok ? 1 : 0;
-            if (ok) unlock(game);
-        }
-    };
-} // namespace
+void AchievementManager::recheck(CarWash &game, AchievementEventType type) {
+    if (anyDue(game, type)) flushPending(game);
+    armHeadroom(game);
+}
 
-/**
- * @brief Constructs the achievement manager and registers all achievements.
- *
- * Achievements are created as polymorphic objects with different criteria:
- * - Threshold achievements based on game metrics
- * - Day-end achievements (perfect day, high revenue day, high satisfaction day)
- * - Hidden achievements that reveal only after unlocking
- */
-AchievementManager::AchievementManager() {
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "ops_first_wash", "First Wash", "Serve your first customer",
-        AchievementCategory::Operations, AchievementRarity::Common,
-        ThresholdAch::Metric::CarsServedTotal, 1,
-        AchievementReward{20.0, 0, 0.0, 0.0}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "ops_50", "Busy Day", "Serve 50 total cars",
-        AchievementCategory::Operations, AchievementRarity::Common,
-        ThresholdAch::Metric::CarsServedTotal, 50,
-        AchievementReward{50.0, 1, 0.0, 0.0}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "ops_200", "Carwash Machine", "Serve 200 total cars",
-        AchievementCategory::Operations, AchievementRarity::Rare,
-        ThresholdAch::Metric::CarsServedTotal, 200,
-        AchievementReward{150.0, 2, 0.05, 0.0}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "fin_200cash", "Positive Cashflow", "Reach 200 EUR cash",
-        AchievementCategory::Finance, AchievementRarity::Common,
-        ThresholdAch::Metric::CashTotal, 200,
-        AchievementReward{30.0, 0, 0.0, 0.0}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "fin_1000cash", "Stacking Bills", "Reach 1000 EUR cash",
-        AchievementCategory::Finance, AchievementRarity::Rare,
-        ThresholdAch::Metric::CashTotal, 1000,
-        AchievementReward{200.0, 1, 0.0, 0.0}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "rep_400", "Trusted Brand", "Reputation score reaches 4.00",
-        AchievementCategory::Reputation, AchievementRarity::Rare,
-        ThresholdAch::Metric::ReputationScore, 400,
-        AchievementReward{0.0, 2, 0.0, 0.05}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "rep_470", "Local Legend", "Reputation score reaches 4.70",
-        AchievementCategory::Reputation, AchievementRarity::Epic,
-        ThresholdAch::Metric::ReputationScore, 470,
-        AchievementReward{150.0, 3, 0.0, 0.10}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "mgmt_supplies_5", "Restocked", "Buy 5 supply packs total",
-        AchievementCategory::Management, AchievementRarity::Common,
-        ThresholdAch::Metric::SuppliesPacks, 5,
-        AchievementReward{0.0, 1, 0.0, 0.0}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "mgmt_upg_1", "First Upgrade", "Buy your first upgrade",
-        AchievementCategory::Management, AchievementRarity::Common,
-        ThresholdAch::Metric::UpgradesBought, 1,
-        AchievementReward{0.0, 0, 0.05, 0.0}));
-
-    list_.push_back(std::make_unique<ThresholdAch>(
-        "mgmt_upg_3", "Fully Invested", "Buy 3 upgrades total",
-        AchievementCategory::Management, AchievementRarity::Rare,
-        ThresholdAch::Metric::UpgradesBought, 3,
-        AchievementReward{0.0, 1, 0.10, 0.05}));
-
-    list_.push_back(std::make_unique<PerfectDayAch>(
-        "ops_perfect_day", "Perfect Day", "End a day with 0 lost customers and 5+ served",
-        AchievementCategory::Operations, AchievementRarity::Epic,
-        5, AchievementReward{100.0, 2, 0.05, 0.05}));
-
-    list_.push_back(std::make_unique<RevenueDayAch>(
-        "fin_big_day", "Big Day", "End a day with 120+ EUR revenue",
-        AchievementCategory::Finance, AchievementRarity::Rare,
-        120.0, AchievementReward{80.0, 1, 0.0, 0.0}, false));
-
-    list_.push_back(std::make_unique<AvgSatDayAch>(
-        "hidden_perfectionist", "Perfectionist", "End a day with avg satisfaction >= 4.80",
-        AchievementCategory::Hidden, AchievementRarity::Legendary,
-        4.80, AchievementReward{200.0, 3, 0.05, 0.10}, true));
+void AchievementManager::beginCoalescing(const CarWash &game) {
+    coalescing_ = true;
+    armHeadroom(game);
 }
 
+void AchievementManager::flushPending(CarWash &game) {
+    if (pending_.cars == 0 && pending_.lost == 0) return;
+    const Pending p = pending_;
+    pending_ = Pending{};
+    if (p.cars > 0) {
+        AchievementEvent ev;
+        ev.type = AchievementEventType::Served;
+        ev.cars = p.cars;
+        ev.satisfactionSum = p.satisfactionSum;
+        ev.revenue = p.revenue;
+        route(game, ev);
+    }
+    if (p.lost > 0) {
+        AchievementEvent ev;
+        ev.type = AchievementEventType::Lost;
+        ev.lost = p.lost;
+        route(game, ev);
+    }
+}
 
-/**
- * @brief Dispatches a gameplay event to all achievements.
- *
- * Each achievement is given the same event payload and can decide whether to update
- * progress or unlock.
- *
- * @param game Game state used to read metrics and apply rewards.
- * @param ev Event payload describing the gameplay occurrence.
- */
-void AchievementManager::dispatch(CarWash &game, const AchievementEvent &ev) {
-    for (auto &a: list_) a->onEvent(game, ev);
+void AchievementManager::endCoalescing(CarWash &game) {
+    coalescing_ = false;
+    flushPending(game);
 }
 
 /**
  * @brief Notifies the achievement system about served cars.
  *
+ * While coalescing, the outcome is only added to the pending aggregate and taken off the
+ * headroom; the live slots are checked only once the headroom runs out.
+ *
  * @param game Game state.
  * @param cars Number of cars served.
- * @param satisfaction Satisfaction achieved.
+ * @param satisfaction Satisfaction achieved per car.
  * @param revenue Revenue generated.
  */
 void AchievementManager::onServed(CarWash &game, int cars, double satisfaction, double revenue) {
+    if (coalescing_) {
+        pending_.cars += cars;
+        pending_.satisfactionSum += satisfaction * cars;
+        pending_.revenue += revenue;
+        headroom_.cars -= cars;
+        headroom_.cash -= revenue;
+        if (headroom_.served || headroom_.cars <= 0 || headroom_.cash < CASH_SLACK) {
+            recheck(game, AchievementEventType::Served);
+        }
+        return;
+    }
     AchievementEvent ev;
     ev.type = AchievementEventType::Served;
     ev.cars = cars;
-    ev.satisfaction = satisfaction;
+    ev.satisfactionSum = satisfaction * cars;
     ev.revenue = revenue;
     dispatch(game, ev);
 }
@@ -419,6 +342,11 @@ void AchievementManager::onServed(CarWash &game, int cars, double satisfaction,
  * @param game Game state.
  */
 void AchievementManager::onLost(CarWash &game) {
+    if (coalescing_) {
+        pending_.lost++;
+        if (headroom_.lost) recheck(game, AchievementEventType::Lost);
+        return;
+    }
     AchievementEvent ev;
     ev.type = AchievementEventType::Lost;
     dispatch(game, ev);
@@ -503,6 +431,37 @@ void AchievementManager::onStructureChanged(CarWash &game) {
     dispatch(game, ev);
 }
 
+void AchievementManager::save(BinaryWriter &w) const {
+    w.i32(totalSuppliesPacks_);
+    w.i32(totalUpgrades_);
+    w.i32(perfectDays_);
+    w.u32(static_cast<std::uint32_t>(catalog_->size()));
+    for (size_t i = 0; i < catalog_->size(); ++i) {
+        w.str(std::string(catalog_->def(i).id));
+        w.boolean(isUnlocked(i));
+        w.i32(shownProgress(i));
+    }
+}
+
+void AchievementManager::load(BinaryReader &r) {
+    totalSuppliesPacks_ = r.i32();
+    totalUpgrades_ = r.i32();
+    perfectDays_ = r.i32();
+    const size_t n = r.count(9);
+    for (size_t k = 0; k < n; ++k) {
+        const std::string id = r.str();
+        const bool unlocked = r.boolean();
+        const int progress = r.i32();
+        const int found = catalog_->find(id);
+        if (found < 0) continue;
+        const auto i = static_cast<size_t>(found);
+        const std::uint64_t bit = std::uint64_t{1} << (i % 64);
+        unlocked_[i / 64] = unlocked ? unlocked_[i / 64] | bit : unlocked_[i / 64] & ~bit;
+        progress_[i] = progress;
+    }
+    buildIndex();
+}
+
 /**
  * @brief Prints achievements in a deterministic, user-friendly order.
  *
@@ -518,17 +477,35 @@ void AchievementManager::onStructureChanged(CarWash &game) {
 void AchievementManager::print(std::ostream &os) const {
     os << "=== ACHIEVEMENTS ===\n";
 
-    std::vector<const Achievement *> v;
-    v.reserve(list_.size());
-    for (const auto &p: list_) v.push_back(p.get());
+    // numele si descrierea raman ascunse pana la deblocare
+    const auto shown = [this](size_t i) {
+        const AchievementDef &d = catalog_->def(i);
+        const bool masked = d.hidden && !isUnlocked(i);
+        return std::pair<std::string_view, std::string_view>{
+            masked ? "???" : d.name, masked ? "Hidden achievement" : d.desc
+        };
+    };
+
+    std::vector<size_t> v(catalog_->size());
+    for (size_t i = 0; i < v.size(); ++i) v[i] = i;
 
-    std::sort(v.begin(), v.end(), [](const Achievement *a, const Achievement *b) {
-        if (a->unlocked() != b->unlocked()) return a->unlocked();
-        if (a->category() != b->category()) return static_cast<int>(a->category()) < static_cast<int>(b->category());
-        return a->displayName() < b->displayName();
+    std::sort(v.begin(), v.end(), [&](size_t i, size_t j) {
+        const AchievementDef &a = catalog_->def(i);
+        const AchievementDef &b = catalog_->def(j);
+        if (isUnlocked(i) != isUnlocked(j)) return isUnlocked(i);
+        if (a.category != b.category) return static_cast<int>(a.category) < static_cast<int>(b.category);
+        return shown(i).first < shown(j).first;
     });
 
-    for (const auto *a: v) os << *a << "\n";
+    for (size_t i: v) {
+        const AchievementDef &d = catalog_->def(i);
+        const auto [name, desc] = shown(i);
+        os << (isUnlocked(i) ? "[UNLOCKED] " : "[LOCKED] ");
+        os << name << " | " << desc;
+        os << " | " << catToStr(d.category) << " | " << rarityToStr(d.rarity);
+        os << " | hidden=" << (d.hidden ? "1" : "0");
+        os << " | " << shownProgress(i) << "/" << targetOf(d) << "\n";
+    }
 
     os << "Stats: supplies_packs=" << totalSuppliesPacks()
             << " upgrades=" << totalUpgrades()
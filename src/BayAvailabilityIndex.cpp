@@ -0,0 +1,83 @@
+#include "../headers/BayAvailabilityIndex.h"
+
+bool BayAvailabilityIndex::Heap::less(int a, int b, const std::vector<int> &avail) const noexcept {
+    const int ka = avail[static_cast<size_t>(a)];
+    const int kb = avail[static_cast<size_t>(b)];
+    return ka != kb ? ka < kb : a < b;
+}
+
+void BayAvailabilityIndex::Heap::place(size_t i, int bay) {
+    heap_[i] = bay;
+    pos_[static_cast<size_t>(bay)] = static_cast<int>(i);
+}
+
+void BayAvailabilityIndex::Heap::siftUp(size_t i, const std::vector<int> &avail) {
+    const int bay = heap_[i];
+    while (i > 0) {
+        const size_t parent = (i - 1) / 2;
+        if (!less(bay, heap_[parent], avail)) break;
+        place(i, heap_[parent]);
+        i = parent;
+    }
+    place(i, bay);
+}
+
+void BayAvailabilityIndex::Heap::siftDown(size_t i, const std::vector<int> &avail) {
+    const int bay = heap_[i];
+    const size_t n = heap_.size();
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && less(heap_[child + 1], heap_[child], avail)) ++child;
+        if (!less(heap_[child], bay, avail)) break;
+        place(i, heap_[child]);
+        i = child;
+    }
+    place(i, bay);
+}
+
+void BayAvailabilityIndex::Heap::clear() {
+    heap_.clear();
+    pos_.clear();
+}
+
+void BayAvailabilityIndex::Heap::insert(int bay, const std::vector<int> &avail) {
+    if (pos_.size() <= static_cast<size_t>(bay)) pos_.resize(static_cast<size_t>(bay) + 1, -1);
+    heap_.push_back(bay);
+    siftUp(heap_.size() - 1, avail);
+}
+
+void BayAvailabilityIndex::Heap::update(int bay, const std::vector<int> &avail) {
+    if (static_cast<size_t>(bay) >= pos_.size() || pos_[static_cast<size_t>(bay)] < 0) return;
+    const auto i = static_cast<size_t>(pos_[static_cast<size_t>(bay)]);
+    siftUp(i, avail);
+    siftDown(static_cast<size_t>(pos_[static_cast<size_t>(bay)]), avail);
+}
+
+void BayAvailabilityIndex::clear() {
+    for (auto &h: heaps_) h.clear();
+    avail_.clear();
+    caps_.clear();
+}
+
+void BayAvailabilityIndex::add(ServiceKindMask caps, int availMin) {
+    const int bay = size();
+    avail_.push_back(availMin);
+    caps_.push_back(caps);
+    for (size_t k = 0; k < kKinds; ++k) {
+        if (caps & kindBit(static_cast<ServiceKind>(k))) heaps_[k].insert(bay, avail_);
+    }
+}
+
+void BayAvailabilityIndex::update(int bay, int availMin) {
+    avail_[static_cast<size_t>(bay)] = availMin;
+    const ServiceKindMask caps = caps_[static_cast<size_t>(bay)];
+    for (size_t k = 0; k < kKinds; ++k) {
+        if (caps & kindBit(static_cast<ServiceKind>(k))) heaps_[k].update(bay, avail_);
+    }
+}
+
+int BayAvailabilityIndex::earliest(ServiceKind kind) const noexcept {
+    const Heap &h = heaps_[static_cast<size_t>(kind)];
+    return h.empty() ? -1 : h.top();
+}
@@ -0,0 +1,26 @@
+#include "../headers/BinaryIO.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+void BinaryWriter::writeFile(const std::string &path) const {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) throw SaveFileException("Nu pot scrie fisierul: " + tmp);
+        f.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+        if (!f) throw SaveFileException("Scriere esuata: " + tmp);
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw SaveFileException("Nu pot redenumi " + tmp + " in " + path);
+    }
+}
+
+BinaryReader BinaryReader::fromFile(const std::string &path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) throw SaveFileException("Nu pot deschide fisierul: " + path);
+    std::string data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    return BinaryReader(std::move(data));
+}
@@ -1,33 +1,133 @@
 #include "../headers/CarQueue.h"
 #include "../headers/Customer.h"
+#include "../headers/BinaryIO.h"
 
-#include <cstdlib>
 #include <ostream>
+#include <type_traits>
+#include <utility>
 
-void CarQueue::generateRandomCustomers() {
-    for (int i = 0; i < demandPerHour_; ++i) {
-        double baseBudget = 10.0 + std::rand() % 20; // 10 .. 30 EUR
-        double impatience = 0.5 + (std::rand() % 150) / 100.0; // 0.5 .. 2.0
+void CarQueue::generateRandomCustomer(int arrivalMin, Rng &rng) {
+    double baseBudget = 10.0 + rng.uniformInt(0, 19); // 10 .. 30 EUR
+    int impatienceCenti = 50 + rng.uniformInt(0, 149); // 0.5 .. 2.0
 
-        int t = std::rand() % 4;
-        std::unique_ptr<Customer> c;
-        if (t == 0) c = std::make_unique<RushedCustomer>(nextId_, baseBudget, impatience);
-        else if (t == 1) c = std::make_unique<BudgetCustomer>(nextId_, baseBudget, impatience);
-        else if (t == 2) c = std::make_unique<PremiumCustomer>(nextId_, baseBudget * 1.5, impatience);
-        else c = std::make_unique<EcoCustomer>(nextId_, baseBudget, impatience);
+    Record r;
+    r.type = static_cast<CustomerType>(rng.uniformInt(0, 3));
+    r.id = static_cast<std::uint32_t>(nextId_++);
+    r.arrivalMin = arrivalMin;
+    r.budget = static_cast<float>(r.type == CustomerType::Premium ? baseBudget * 1.5 : baseBudget);
+    r.impatienceCenti = static_cast<std::uint16_t>(impatienceCenti);
+    push(r);
+}
+
+/**
+ * @brief Doubles the ring capacity (kept a power of two) and unwraps the contents.
+ */
+void CarQueue::grow() {
+    const size_t newCap = capacity() == 0 ? 16 : capacity() * 2;
+    std::vector<std::uint32_t> ids(newCap);
+    std::vector<std::int32_t> arrivals(newCap);
+    std::vector<float> budgets(newCap);
+    std::vector<std::uint16_t> impatience(newCap);
+    std::vector<CustomerType> types(newCap);
+    for (size_t i = 0; i < count_; ++i) {
+        const size_t s = slot(i);
+        ids[i] = ids_[s];
+        arrivals[i] = arrivals_[s];
+        budgets[i] = budgets_[s];
+        impatience[i] = impatience_[s];
+        types[i] = types_[s];
+    }
+    ids_.swap(ids);
+    arrivals_.swap(arrivals);
+    budgets_.swap(budgets);
+    impatience_.swap(impatience);
+    types_.swap(types);
+    head_ = 0;
+}
 
-        ++nextId_;
-        q_.push_back(std::move(c));
+void CarQueue::push(const Record &r) {
+    if (count_ == capacity()) grow();
+    const size_t s = slot(count_);
+    ids_[s] = r.id;
+    arrivals_[s] = r.arrivalMin;
+    budgets_[s] = r.budget;
+    impatience_[s] = r.impatienceCenti;
+    types_[s] = r.type;
+    if (count_++ == 0) refreshFront();
+}
+
+/**
+ * @brief Rebuilds the in-place head object after the head changed.
+ */
+void CarQueue::refreshFront() {
+    if (count_ == 0) {
+        front_.emplace<std::monostate>();
+        return;
+    }
+    const int id = static_cast<int>(ids_[head_]);
+    const double budget = budgets_[head_];
+    const double impatience = impatience_[head_] / 100.0;
+    switch (types_[head_]) {
+        case CustomerType::Rushed: front_.emplace<RushedCustomer>(id, budget, impatience);
+            break;
+        case CustomerType::Budget: front_.emplace<BudgetCustomer>(id, budget, impatience);
+            break;
+        case CustomerType::Premium: front_.emplace<PremiumCustomer>(id, budget, impatience);
+            break;
+        case CustomerType::Eco: front_.emplace<EcoCustomer>(id, budget, impatience);
+            break;
     }
 }
 
+const Customer &CarQueue::front() const {
+    const Customer *c = std::visit([](const auto &v) -> const Customer * {
+        if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) return nullptr;
+        else return &v;
+    }, front_);
+    return *c;
+}
+
+Customer &CarQueue::front() {
+    return const_cast<Customer &>(std::as_const(*this).front());
+}
+
+CarQueue::Record CarQueue::frontRecord() const {
+    Record r;
+    r.id = ids_[head_];
+    r.arrivalMin = arrivals_[head_];
+    r.budget = budgets_[head_];
+    r.impatienceCenti = impatience_[head_];
+    r.type = types_[head_];
+    return r;
+}
+
+std::unique_ptr<Customer> CarQueue::makeCustomer(const Record &r) {
+    const int id = static_cast<int>(r.id);
+    const double budget = r.budget;
+    const double impatience = r.impatienceCenti / 100.0;
+    switch (r.type) {
+        case CustomerType::Rushed: return std::make_unique<RushedCustomer>(id, budget, impatience);
+        case CustomerType::Budget: return std::make_unique<BudgetCustomer>(id, budget, impatience);
+        case CustomerType::Premium: return std::make_unique<PremiumCustomer>(id, budget, impatience);
+        case CustomerType::Eco: return std::make_unique<EcoCustomer>(id, budget, impatience);
+    }
+    return nullptr;
+}
+
 std::unique_ptr<Customer> CarQueue::pop() {
-    if (q_.empty()) return nullptr;
-    std::unique_ptr<Customer> c = std::move(q_.front());
-    q_.pop_front();
+    if (empty()) return nullptr;
+    std::unique_ptr<Customer> c = makeCustomer(frontRecord());
+    drop();
     return c;
 }
 
+void CarQueue::drop() {
+    if (empty()) return;
+    head_ = (head_ + 1) & (capacity() - 1);
+    --count_;
+    refreshFront();
+}
+
 void CarQueue::failOne() {
     ++lost_;
 }
@@ -41,11 +141,53 @@ void CarQueue::decreaseDemand() {
 }
 
 void CarQueue::print(std::ostream &os) const {
-    os << "Queue{pending=" << q_.size()
+    os << "Queue{pending=" << count_
             << ", lost=" << lost_
             << ", demand/h=" << demandPerHour_ << "}";
 }
 
+void CarQueue::save(BinaryWriter &w) const {
+    w.i32(nextId_);
+    w.i32(demandPerHour_);
+    w.i32(lost_);
+    w.u32(static_cast<std::uint32_t>(count_));
+    for (size_t i = 0; i < count_; ++i) {
+        const size_t s = slot(i);
+        w.u32(ids_[s]);
+        w.i32(arrivals_[s]);
+        w.pod(budgets_[s]);
+        w.pod(impatience_[s]);
+        w.u8(static_cast<std::uint8_t>(types_[s]));
+    }
+}
+
+void CarQueue::load(BinaryReader &r) {
+    nextId_ = r.i32();
+    demandPerHour_ = r.i32();
+    lost_ = r.i32();
+    const size_t n = r.count(15);
+
+    ids_.clear();
+    arrivals_.clear();
+    budgets_.clear();
+    impatience_.clear();
+    types_.clear();
+    head_ = 0;
+    count_ = 0;
+    front_.emplace<std::monostate>();
+    for (size_t i = 0; i < n; ++i) {
+        Record rec;
+        rec.id = r.u32();
+        rec.arrivalMin = r.i32();
+        rec.budget = r.pod<float>();
+        rec.impatienceCenti = r.pod<std::uint16_t>();
+        const std::uint8_t type = r.u8();
+        if (type > static_cast<std::uint8_t>(CustomerType::Eco)) throw SaveFileException("Tip de client invalid");
+        rec.type = static_cast<CustomerType>(type);
+        push(rec);
+    }
+}
+
 std::ostream &operator<<(std::ostream &os, const CarQueue &cq) {
     cq.print(os);
     return os;
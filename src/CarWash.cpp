@@ -4,11 +4,20 @@
 #include "../headers/WaxService.h"
 #include "../headers/EcoService.h"
 #include "../headers/Customer.h"
+#include "../headers/NullStream.h"
+#include "../headers/ServiceFactory.h"
+#include "../headers/ThreadPool.h"
+#include "../headers/ReplayLog.h"
+#include "../headers/ReportExporter.h"
+#include "../headers/HistoryLog.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cmath>
+#include <filesystem>
 #include <iomanip>
+#include <random>
 #include <iostream>
 #include <sstream>
 
@@ -30,7 +39,8 @@ CarWash::CarWash(std::string n, Inventory inv, int openM, int closeM)
       inv_(inv),
       openMin_(openM),
       closeMin_(closeM),
-      nowMin_(openM) {
+      nowMin_(openM),
+      rng_((static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}()) {
     if (openM >= closeM) {
         throw CarWashException("Ore program invalide");
     }
@@ -41,6 +51,20 @@ CarWash::CarWash(std::string n, Inventory inv, int openM, int closeM)
 
     pricing_ = std::make_unique<BalancedPricing>();
     currentReport_.beginDay(day_);
+    scheduleDay();
+}
+
+/**
+ * @brief Returns the stream used for console output.
+ *
+ * Headless instances get a per-thread discarding stream, so explicit show* calls stay valid.
+ *
+ * @return Configured output stream or a null sink.
+ */
+std::ostream &CarWash::out() const {
+    if (out_) return *out_;
+    static thread_local NullStream sink;
+    return sink;
 }
 
 /**
@@ -65,16 +89,20 @@ bool CarWash::sameCaseInsensitive(const std::string &a, const std::string &b) co
 /**
  * @brief Finds the index of a service by name (case-insensitive).
  *
+ * Hash lookup in serviceIds_; when several services share a name the first one added wins.
+ *
  * @param name Service display name to search for.
  * @return Index in services_ if found; -1 otherwise.
  */
 int CarWash::findService(const std::string &name) const {
-    for (size_t i = 0; i < services_.size(); ++i) {
-        if (services_[i] && sameCaseInsensitive(services_[i]->name(), name)) {
-            return static_cast<int>(i);
-        }
-    }
-    return -1;
+    const auto it = serviceIds_.find(normalizedName(name));
+    return it != serviceIds_.end() ? it->second : -1;
+}
+
+std::string CarWash::normalizedName(const std::string &name) {
+    std::string key(name);
+    for (char &c: key) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return key;
 }
 
 /**
@@ -88,7 +116,7 @@ int CarWash::findService(const std::string &name) const {
  */
 bool CarWash::addService(const WashService &s) {
     if (services_.size() >= MAX_SERV) return false;
-    services_.push_back(s.clone());
+    attachService(s.clone());
     if (nanoCoatingEnabled_) applyNanoCoatingToWaxServices();
     achievements_.onStructureChanged(*this);
     return true;
@@ -105,16 +133,57 @@ bool CarWash::addService(const WashService &s) {
  */
 bool CarWash::addBay(const WashBay &b) {
     if (bays_.size() >= MAX_BAYS) return false;
-    bays_.push_back(std::make_unique<WashBay>(b));
-    if (bays_.back()->id() % 2 == 0) {
-        bays_.back()->addWax();
+    WashBay bay(b);
+    if (bay.id() % 2 == 0) {
+        bay.addWax();
     } else {
-        bays_.back()->addDeluxe();
+        bay.addDeluxe();
+    }
+    attachBay(std::move(bay));
+    if (bays_.back().availAt() > nowMin_) {
+        sim_.schedule(bays_.back().availAt(), SimEventType::BayFinished, static_cast<int>(bays_.size() - 1));
     }
     achievements_.onStructureChanged(*this);
     return true;
 }
 
+void CarWash::attachService(std::shared_ptr<WashService> s) {
+    services_.push_back(std::move(s));
+    servicePtrs_.push_back(services_.back().get());
+    serviceIds_.emplace(normalizedName(services_.back()->name()), static_cast<int>(services_.size() - 1));
+
+    const std::string &name = services_.back()->name();
+    int key = serviceKeys_->find(name);
+    if (key < 0) {
+        auto keys = std::make_shared<ServiceKeys>(*serviceKeys_);
+        key = keys->intern(name);
+        serviceKeys_ = std::move(keys);
+        currentReport_.setKeys(serviceKeys_);
+    }
+    saleKeys_.push_back(static_cast<ServiceKey>(key));
+    choiceIndex_.invalidate();
+}
+
+void CarWash::attachBay(WashBay b) {
+    bays_.push_back(std::move(b));
+    bayIndex_.add(bays_.back().capabilities(), bays_.back().availAt());
+}
+
+/**
+ * @brief Returns service i for modification, cloning it first if another fork still shares it.
+ *
+ * @param i Index in services_.
+ * @return Service owned by this instance alone.
+ */
+WashService &CarWash::mutableService(size_t i) {
+    if (services_[i].use_count() > 1) {
+        services_[i] = services_[i]->clone();
+        servicePtrs_[i] = services_[i].get();
+        choiceIndex_.invalidate();
+    }
+    return *services_[i];
+}
+
 /**
  * @brief Applies Nano Coating effect to all WaxService instances currently registered.
  *
@@ -123,11 +192,9 @@ bool CarWash::addBay(const WashBay &b) {
  * we safely detect WaxService with dynamic_cast and enable the upgrade behavior.
  */
 void CarWash::applyNanoCoatingToWaxServices() {
-    for (auto &s: services_) {
-        if (!s) continue;
-        if (auto *wax = dynamic_cast<WaxService *>(s.get())) {
-            wax->enableNanoCoating(true);
-        }
+    for (size_t i = 0; i < services_.size(); ++i) {
+        if (!services_[i] || !dynamic_cast<const WaxService *>(services_[i].get())) continue;
+        static_cast<WaxService &>(mutableService(i)).enableNanoCoating(true);
     }
 }
 
@@ -147,9 +214,10 @@ void CarWash::enableNanoCoating() {
 /**
  * @brief Attempts to book a number of cars for a named service across available bays.
  *
- * For each car, the function tries to find a bay that supports the service, checks
+ * For each car, the function takes the capable bay that frees up earliest, checks
  * time feasibility (must finish before closing), and checks inventory availability.
- * If successful, the bay is booked and revenue is collected.
+ * If successful, the bay is booked (never earlier than the current minute), revenue is
+ * collected and the bay's BayFinished event is scheduled.
  *
  * @param serviceName Service name to book.
  * @param cars Number of cars to schedule.
@@ -163,30 +231,46 @@ int CarWash::bookCars(const std::string &serviceName, int cars) {
     if (si < 0) {
         throw InvalidServiceException("Serviciul nu exista: " + serviceName);
     }
+    return bookCars(si, cars);
+}
+
+int CarWash::bookCars(int serviceId, int cars) {
+    if (serviceId < 0 || static_cast<size_t>(serviceId) >= services_.size()) {
+        throw InvalidServiceException("Serviciul nu exista: #" + std::to_string(serviceId));
+    }
     if (cars <= 0) {
         throw BookingException("Numar de masini invalid");
     }
-    const WashService &sp = *services_.at(static_cast<size_t>(si));
+    const WashService &sp = *services_[static_cast<size_t>(serviceId)];
 
     int booked = 0;
     for (int c = 0; c < cars; ++c) {
-        bool ok = false;
-        for (auto &bay: bays_) {
-            if (!bay->canDo(sp.name())) continue;
-            int finish = bay->availAt() + sp.duration();
-            if (finish <= closeMin_ && inv_.takeIfCan(sp, 1)) {
-                bay->bookOne(sp, bay->availAt());
-                cash_ += sp.price();
-                ++booked;
-                ok = true;
-                break;
-            }
-        }
-        if (!ok) break;
+        const int bi = bayIndex_.earliest(sp.kind());
+        if (bi < 0) break;
+        const int start = std::max(bayIndex_.availAt(bi), nowMin_);
+        const int finish = start + WashBay::durationFor(sp, speedFactor_);
+        if (finish > closeMin_ || !inv_.takeIfCan(sp, 1)) break;
+        startOnBay(static_cast<size_t>(bi), sp);
+        ++booked;
     }
     return booked;
 }
 
+/**
+ * @brief Books a service on a bay and schedules the bay's BayFinished event.
+ *
+ * Bay processing time is scaled by the current speed factor.
+ *
+ * @param bi Bay index in bays_.
+ * @param sp Service to run.
+ */
+void CarWash::startOnBay(size_t bi, const WashService &sp) {
+    const int finish = bays_[bi].bookOne(sp, nowMin_, speedFactor_);
+    bayIndex_.update(static_cast<int>(bi), finish);
+    cash_ += sp.price();
+    sim_.schedule(finish, SimEventType::BayFinished, static_cast<int>(bi));
+}
+
 /**
  * @brief Applies a multiplicative factor to all service prices.
  *
@@ -194,8 +278,8 @@ int CarWash::bookCars(const std::string &serviceName, int cars) {
  */
 void CarWash::adjustServicePrices(double factor) {
     if (factor <= 0.0) return;
-    for (auto &s: services_) {
-        if (s) s->applyFactor(factor);
+    for (size_t i = 0; i < services_.size(); ++i) {
+        if (services_[i]) mutableService(i).applyFactor(factor);
     }
 }
 
@@ -213,14 +297,14 @@ void CarWash::applyPricingStrategy() {
  *
  * @param mode One of: \"aggressive\", \"conservative\", or any other value for balanced.
  */
+std::unique_ptr<PricingStrategy> CarWash::makePricing(const std::string &mode) {
+    if (mode == "aggressive") return std::make_unique<AggressivePricing>();
+    if (mode == "conservative") return std::make_unique<ConservativePricing>();
+    return std::make_unique<BalancedPricing>();
+}
+
 void CarWash::setPricingMode(const std::string &mode) {
-    if (mode == "aggressive") {
-        pricing_ = std::make_unique<AggressivePricing>();
-    } else if (mode == "conservative") {
-        pricing_ = std::make_unique<ConservativePricing>();
-    } else {
-        pricing_ = std::make_unique<BalancedPricing>();
-    }
+    pricing_ = makePricing(mode);
     logEvent("Schimbare strategie preturi: " + pricing_->name());
 }
 
@@ -236,10 +320,23 @@ void CarWash::endCurrentDay() {
                              ? dailySatisfactionSum_ / dailySatisfiedCustomers_
                              : 0.0;
 
+    applyReputation();
     achievements_.onDayEnd(*this, day_, dailyCarsServed_, dailyLost_, dailyRevenue_, dailyAvgSat);
+    if (journal_) {
+        JournalRecord r;
+        r.type = JournalType::DayEnd;
+        r.ref = static_cast<std::uint32_t>(dailyCarsServed_);
+        r.extra = static_cast<std::uint32_t>(dailyLost_);
+        r.value = static_cast<float>(dailyAvgSat);
+        r.amount = dailyRevenue_;
+        journal(r);
+    }
 
     currentReport_.finalize(dailyCarsServed_, dailyLost_, dailyAvgSat, dailyRevenue_);
-    reports_.push_back(currentReport_);
+    if (exporter_) exporter_->addDay(currentReport_);
+    mutableReports().append(currentReport_);
+    stats_.add(*reports_, reports_->size() - 1);
+    streaming_.addDay(dailyRevenue_, dailyLost_, dailyAvgSat);
 
     dailyCarsServed_ = 0;
     dailySatisfactionSum_ = 0.0;
@@ -247,113 +344,265 @@ void CarWash::endCurrentDay() {
     dailyLost_ = 0;
     dailyRevenue_ = 0.0;
 
-    for (auto &b: bays_) b->reset(openMin_);
+    for (size_t i = 0; i < bays_.size(); ++i) {
+        bays_[i].reset(openMin_);
+        bayIndex_.update(static_cast<int>(i), openMin_);
+    }
     nowMin_ = openMin_;
+    scheduleDay();
 
     goals_.checkAll(*this);
 
-    events_.startNewDay(*this);
+    events_.startNewDay(*this, rng_.events);
     applyPricingStrategy();
 
     ++day_;
     currentReport_.beginDay(day_);
 
-    std::cout << "--- Ziua a fost incheiata. Ziua curenta: " << day_ << " ---\n";
+    if (out_) *out_ << "--- Ziua a fost incheiata. Ziua curenta: " << day_ << " ---\n";
 }
 
 /**
- * @brief Simulates one hour of gameplay.
+ * @brief Schedules the fixed events of the current day.
  *
- * Advances time, generates demand/customers, repeatedly attempts to serve customers
- * based on available bay capacity and speed factor, updates revenue and satisfaction,
- * and applies demand adjustments. If closing time is reached, ends the current day.
+ * Any pending events of the previous day are dropped. Closing and DayEnd share the
+ * closing minute; Closing always fires first (see SimEventType ordering).
  */
-void CarWash::simulateHour() {
-    nowMin_ += 60;
+void CarWash::scheduleDay() {
+    sim_.clear();
+    sim_.schedule(closeMin_, SimEventType::Closing);
+    sim_.schedule(closeMin_, SimEventType::DayEnd);
+    for (size_t i = 0; i < bays_.size(); ++i) {
+        if (bays_[i].availAt() > nowMin_) {
+            sim_.schedule(bays_[i].availAt(), SimEventType::BayFinished, static_cast<int>(i));
+        }
+    }
+}
 
-    int extra = baseDemandBonus_ > 0 ? baseDemandBonus_ : 0;
-    for (int i = 0; i < extra; ++i) queue_.increaseDemand();
-    queue_.generateRandomCustomers();
+/**
+ * @brief Records one lost customer across all subsystems that track losses.
+ */
+void CarWash::loseCustomer(const CarQueue::Record &who, LossReason reason) {
+    queue_.failOne();
+    ++dailyLost_;
+    hourReputation_.lost();
+    achievements_.onLost(*this);
+    if (journal_ || exporter_) {
+        JournalRecord r;
+        r.type = JournalType::Lost;
+        r.subject = static_cast<std::uint8_t>(who.type);
+        r.ref = who.id;
+        r.extra = static_cast<std::uint32_t>(reason);
+        journal(r);
+    }
+    demand_.fail();
+}
 
-    std::vector<WashService *> servicePtrs;
-    servicePtrs.reserve(services_.size());
-    for (auto &s: services_) if (s) servicePtrs.push_back(s.get());
+void CarWash::applyReputation() {
+    if (hourReputation_.empty()) return;
+    reputation_.apply(hourReputation_);
+    hourReputation_ = ReputationBatch{};
+}
 
-    int attempts = static_cast<int>(bays_.size()) * static_cast<int>(4 * speedFactor_);
-    int processed = 0;
+void CarWash::journal(JournalRecord r) {
+    if (!journal_ && !exporter_) return;
+    r.day = static_cast<std::uint32_t>(day_);
+    r.minute = static_cast<std::uint16_t>(nowMin_);
+    if (journal_) journal_->append(r);
+    if (exporter_) exporter_->addOutcome(r);
+}
 
-    for (int k = 0; k < attempts; ++k) {
-        if (queue_.empty()) break;
+void CarWash::journalPurchase(SupplyItem item, int packs, double cost) {
+    if (!journal_) return;
+    JournalRecord r;
+    r.type = JournalType::BuySupplies;
+    r.subject = static_cast<std::uint8_t>(item);
+    r.ref = static_cast<std::uint32_t>(packs);
+    r.amount = cost;
+    journal(r);
+}
 
-        auto customer = queue_.pop();
-        if (!customer) break;
+/**
+ * @brief Serves the customers waiting at the current minute.
+ *
+ * The customer at the head of the queue picks a service. If no bay can run it at all,
+ * or it cannot finish before closing, the customer is lost. If every capable bay is
+ * still busy, dispatching stops until the next BayFinished event. Otherwise the car is
+ * booked right away on the earliest-free capable bay and the customer is scored with
+ * the real waiting time.
+ */
+void CarWash::dispatchWaiting() {
+    while (!queue_.empty() && queue_.frontArrival() <= nowMin_) {
+        const CarQueue::Record head = queue_.frontRecord();
+        const int choice = choiceIndex_.choose(head.type, head.budget);
+        if (choice < 0) {
+            queue_.drop();
+            loseCustomer(head, LossReason::NoAffordableService);
+            continue;
+        }
 
-        const WashService *chosen = customer->chooseService(servicePtrs);
-        if (!chosen) {
-            queue_.failOne();
-            ++dailyLost_;
-            reputation_.onLost();
-            achievements_.onLost(*this);
-            demand_.fail();
+        const WashService *chosen = servicePtrs_[static_cast<size_t>(choice)];
+        const int freeBay = bayIndex_.earliest(chosen->kind());
+        const bool fitsToday = nowMin_ + WashBay::durationFor(*chosen, speedFactor_) <= closeMin_;
+        if (freeBay < 0 || !fitsToday) {
+            queue_.drop();
+            loseCustomer(head, freeBay < 0 ? LossReason::NoCapableBay : LossReason::Closing);
             continue;
         }
+        if (bayIndex_.availAt(freeBay) > nowMin_) break;
 
-        try {
-            int got = bookCars(chosen->name(), 1);
-            if (got == 1) {
-                customer->onServed(*chosen, chosen->price(), 0);
-                double sat = customer->satisfaction() + comfortBonus_;
-                if (sat > 5.0) sat = 5.0;
-                if (sat < 0.0) sat = 0.0;
-
-                totalCarsServed_++;
-                totalSatisfaction_ += sat;
-                totalSatisfiedCustomers_++;
-
-                dailyCarsServed_++;
-                dailySatisfactionSum_ += sat;
-                dailySatisfiedCustomers_++;
-                dailyRevenue_ += chosen->price();
-                currentReport_.addServiceSale(chosen->name(), chosen->price());
-
-                processed++;
-                reputation_.onServed(sat);
-                achievements_.onServed(*this, 1, sat, chosen->price());
-                demand_.success();
-            } else {
-                queue_.failOne();
-                ++dailyLost_;
-                reputation_.onLost();
-                achievements_.onLost(*this);
-                demand_.fail();
-            }
-        } catch (const CarWashException &) {
-            queue_.failOne();
-            ++dailyLost_;
-            reputation_.onLost();
-            achievements_.onLost(*this);
-            demand_.fail();
+        if (!inv_.takeIfCan(*chosen, 1)) {
+            queue_.drop();
+            loseCustomer(head, LossReason::OutOfStock);
+            continue;
+        }
+
+        const int waited = nowMin_ - queue_.frontArrival();
+        startOnBay(static_cast<size_t>(freeBay), *chosen);
+
+        Customer &customer = queue_.front();
+        customer.onServed(*chosen, chosen->price(), waited);
+        double sat = customer.satisfaction() + comfortBonus_;
+        queue_.drop();
+        if (sat > 5.0) sat = 5.0;
+        if (sat < 0.0) sat = 0.0;
+
+        totalCarsServed_++;
+        totalSatisfaction_ += sat;
+        totalSatisfiedCustomers_++;
+
+        dailyCarsServed_++;
+        dailySatisfactionSum_ += sat;
+        dailySatisfiedCustomers_++;
+        dailyRevenue_ += chosen->price();
+        streaming_.addCustomer(sat);
+        currentReport_.addServiceSale(saleKeys_[static_cast<size_t>(choice)], chosen->price());
+
+        hourReputation_.served(sat);
+        achievements_.onServed(*this, 1, sat, chosen->price());
+        if (journal_ || exporter_) {
+            JournalRecord r;
+            r.type = JournalType::Served;
+            r.subject = static_cast<std::uint8_t>(head.type);
+            r.ref = head.id;
+            r.extra = static_cast<std::uint32_t>(waited);
+            r.value = static_cast<float>(sat);
+            r.aux = static_cast<std::uint32_t>(chosen->kind());
+            r.amount = chosen->price();
+            journal(r);
+        }
+        demand_.success();
+    }
+}
+
+/**
+ * @brief Runs the discrete-event engine up to a target minute.
+ *
+ * The clock jumps directly from one event timestamp to the next, so the cost depends
+ * on the number of events only. The service-choice index is refreshed once up front,
+ * which picks up any price or catalog change made since the previous call. Arrivals
+ * and bay completions trigger dispatching, Closing drops the customers still waiting
+ * and DayEnd finalizes the day (after which the call returns, because the clock has
+ * been reset to opening time). The reputation changes of the run are applied in one
+ * batch on return.
+ *
+ * @param minute Target minute since midnight of the current day.
+ */
+void CarWash::runUntil(int minute) {
+    choiceIndex_.refresh(servicePtrs_);
+    while (!sim_.empty() && sim_.top().minute <= minute) {
+        const SimEvent ev = sim_.pop();
+        nowMin_ = ev.minute;
+
+        switch (ev.type) {
+            case SimEventType::BayFinished:
+            case SimEventType::Arrival:
+                dispatchWaiting();
+                break;
+            case SimEventType::Closing:
+                while (!queue_.empty()) {
+                    const CarQueue::Record head = queue_.frontRecord();
+                    queue_.drop();
+                    loseCustomer(head, LossReason::Closing);
+                }
+                break;
+            case SimEventType::DayEnd:
+                endCurrentDay();
+                return;
         }
     }
+    if (minute > nowMin_) nowMin_ = std::min(minute, closeMin_);
+    applyReputation();
+}
+
+/**
+ * @brief Simulates one hour of gameplay.
+ *
+ * Draws the hour's arrival times uniformly over the hour (or over what is left until closing),
+ * runs the event engine to the end of the hour and then applies demand adjustments.
+ * Throughput is limited by the real bay finish times and the speed factor.
+ */
+void CarWash::simulateHour() {
+    const int from = nowMin_;
+    const int span = std::min(60, closeMin_ - from);
+    const int servedBefore = totalCarsServed_;
+
+    const int bonus = baseDemandBonus_ + sharedDemandBonus_;
+    int extra = bonus > 0 ? bonus : 0;
+    for (int i = 0; i < extra; ++i) queue_.increaseDemand();
+
+    const int arrivals = span > 0 ? queue_.demand() : 0;
+    std::vector<int> times(static_cast<size_t>(arrivals));
+    for (int &t: times) t = from + rng_.arrivals.uniformInt(0, span - 1);
+    std::sort(times.begin(), times.end());
+    for (int at: times) {
+        queue_.generateRandomCustomer(at, rng_.customers);
+        sim_.schedule(at, SimEventType::Arrival);
+    }
+
+    achievements_.beginCoalescing(*this);
+    runUntil(from + 60);
+    achievements_.endCoalescing(*this);
+
+    const int processed = totalCarsServed_ - servedBefore;
 
     int adj = demand_.adjust();
     if (adj > 0) queue_.increaseDemand();
     if (adj < 0) queue_.decreaseDemand();
     if (adj != 0) demand_.reset();
 
-    if (nowMin_ >= closeMin_) endCurrentDay();
-
-    std::cout << "Ora simulata: procesate=" << processed
+    if (!out_) return;
+    *out_ << "Ora simulata: procesate=" << processed
             << " ramase=" << queue_.size()
             << " pierdute=" << queue_.lostCustomers()
             << " cerere/h=" << queue_.demand() << "\n";
 }
 
+/**
+ * @brief Simulates complete days back to back.
+ *
+ * @param days Number of days to finish.
+ */
+void CarWash::runDays(int days) {
+    if (days <= 0) return;
+    const int target = day_ + days;
+    while (day_ < target) simulateHour();
+}
+
+/**
+ * @brief Re-seeds this instance's random sub-streams.
+ *
+ * @param seed Seed value.
+ */
+void CarWash::seed(std::uint64_t seed) {
+    rng_.reseed(seed);
+}
+
 /**
  * @brief Prints the current customer queue state.
  */
 void CarWash::showQueue() const {
-    std::cout << queue_ << "\n";
+    out() << queue_ << "\n";
 }
 
 /**
@@ -371,7 +620,7 @@ void CarWash::nextCommand() {
  * Nano Coating is a Wax-only feature.
  */
 void CarWash::showServices() const {
-    std::cout << "SERVICII:\n";
+    out() << "SERVICII:\n";
     for (const auto &p: services_) {
         if (!p) continue;
 
@@ -380,7 +629,7 @@ void CarWash::showServices() const {
             extra = wax->nanoCoatingEnabled() ? " nano=ON" : " nano=OFF";
         }
 
-        std::cout << "  - " << *p
+        out() << "  - " << *p
                 << " kind=" << WashService::kindToString(p->kind())
                 << (p->isPremium() ? " [premium]" : "")
                 << extra
@@ -392,18 +641,18 @@ void CarWash::showServices() const {
  * @brief Prints all bays and their current state.
  */
 void CarWash::showBays() const {
-    std::cout << "BAIE (" << bays_.size() << "), create=" << WashBay::totalBaysCreated() << "\n";
-    for (const auto &b: bays_) if (b) std::cout << "  " << *b << "\n";
+    out() << "BAIE (" << bays_.size() << "), create=" << WashBay::totalBaysCreated() << "\n";
+    for (const auto &b: bays_) out() << "  " << b << "\n";
 }
 
 /**
  * @brief Prints detailed status including cash, time, inventory, and queue.
  */
 void CarWash::showStatus() const {
-    std::cout << "=== STATUS ZIUA " << day_ << " ===\n";
-    std::cout << "Bani: " << std::fixed << std::setprecision(2) << cash_ << " EUR\n";
-    std::cout << "Timp: " << nowMin_ << "/" << closeMin_ << "\n";
-    std::cout << "Inventar: " << inv_ << "\n";
+    out() << "=== STATUS ZIUA " << day_ << " ===\n";
+    out() << "Bani: " << std::fixed << std::setprecision(2) << cash_ << " EUR\n";
+    out() << "Timp: " << nowMin_ << "/" << closeMin_ << "\n";
+    out() << "Inventar: " << inv_ << "\n";
     showQueue();
 }
 
@@ -411,72 +660,72 @@ void CarWash::showStatus() const {
  * @brief Prints goal progress and whether all goals have been achieved.
  */
 void CarWash::showGoals() const {
-    goals_.print(std::cout, *this);
-    if (goals_.allAchieved()) std::cout << "Toate obiectivele au fost atinse!\n";
+    goals_.print(out(), *this);
+    if (goals_.allAchieved()) out() << "Toate obiectivele au fost atinse!\n";
 }
 
 /**
  * @brief Prints purchased upgrades and the available upgrades catalog.
  */
 void CarWash::showUpgrades() const {
-    std::cout << "Upgrade-uri cumparate:\n";
+    out() << "Upgrade-uri cumparate:\n";
     if (purchased_.empty()) {
-        std::cout << "  (niciun upgrade)\n";
+        out() << "  (niciun upgrade)\n";
     } else {
-        for (const auto &u: purchased_) if (u) std::cout << "  - " << *u << "\n";
+        for (const auto &u: purchased_) if (u) out() << "  - " << *u << "\n";
     }
 
-    std::cout << "Upgrade-uri disponibile (id -> descriere):\n";
-    std::cout << "  1 -> " << BaySpeedUpgrade() << "\n";
-    std::cout << "  2 -> " << ComfortUpgrade() << "\n";
-    std::cout << "  3 -> " << MarketingUpgrade() << "\n";
-    std::cout << "  4 -> " << NanoCoatingUpgrade() << "\n";
+    out() << "Upgrade-uri disponibile (id -> descriere):\n";
+    out() << "  1 -> " << BaySpeedUpgrade() << "\n";
+    out() << "  2 -> " << ComfortUpgrade() << "\n";
+    out() << "  3 -> " << MarketingUpgrade() << "\n";
+    out() << "  4 -> " << NanoCoatingUpgrade() << "\n";
 }
 
 /**
  * @brief Prints a compact gameplay dashboard with key KPIs.
  */
 void CarWash::showDashboard() const {
-    std::cout << "=========== DASHBOARD ==========\n";
-    std::cout << "Ziua: " << day_ << "\n";
-    std::cout << "Cash: " << std::fixed << std::setprecision(2) << cash_ << " EUR\n";
-    std::cout << "Cars served: " << totalCarsServed_ << "\n";
-    std::cout << "Avg satisfaction: " << std::setprecision(2) << averageSatisfaction() << "\n";
-    std::cout << "Today satisfaction: " << std::setprecision(2) << avgSatisfactionToday()
+    out() << "=========== DASHBOARD ==========\n";
+    out() << "Ziua: " << day_ << "\n";
+    out() << "Cash: " << std::fixed << std::setprecision(2) << cash_ << " EUR\n";
+    out() << "Cars served: " << totalCarsServed_ << "\n";
+    out() << "Avg satisfaction: " << std::setprecision(2) << averageSatisfaction() << "\n";
+    out() << "Today satisfaction: " << std::setprecision(2) << avgSatisfactionToday()
             << " (n=" << servedSamplesToday() << ")\n";
-    std::cout << "Reputation score: " << std::setprecision(2) << reputation_.score() << "\n";
-    std::cout << "Queue: " << queue_ << "\n";
-    std::cout << "SpeedFactor: " << speedFactor_
+    out() << "Reputation score: " << std::setprecision(2) << reputation_.score() << "\n";
+    out() << "Queue: " << queue_ << "\n";
+    out() << "SpeedFactor: " << speedFactor_
             << " | ComfortBonus: " << comfortBonus_ << "\n";
-    goals_.print(std::cout, *this);
-    if (goals_.allAchieved()) std::cout << "Status obiective: COMPLETATE 100%\n";
-    std::cout << "================================\n";
+    goals_.print(out(), *this);
+    if (goals_.allAchieved()) out() << "Status obiective: COMPLETATE 100%\n";
+    out() << "================================\n";
 }
 
 /**
  * @brief Prints all stored daily reports.
  */
 void CarWash::showReports() const {
-    if (reports_.empty()) {
-        std::cout << "Nu exista inca rapoarte zilnice.\n";
+    if (reports_->empty()) {
+        out() << "Nu exista inca rapoarte zilnice.\n";
         return;
     }
-    std::cout << "=== Rapoarte zilnice ===\n";
-    for (const auto &r: reports_) std::cout << r << "\n";
+    out() << "=== Rapoarte zilnice ===\n";
+    for (size_t i = 0; i < reports_->size(); ++i) out() << reports_->at(i) << "\n";
 }
 
 /**
  * @brief Prints the supplies shop and current inventory/cash.
  */
 void CarWash::showShop() const {
-    std::cout << "=== SUPPLY SHOP ===\n";
-    std::cout << "Ai: " << std::fixed << std::setprecision(2) << cash_ << " EUR\n";
-    std::cout << "Inventar curent: " << inv_ << "\n\n";
-    std::cout << "Oferte:\n";
-    std::cout << "  water   : 20 EUR / pack -> +200 water\n";
-    std::cout << "  shampoo : 25 EUR / pack -> +50 shampoo\n";
-    std::cout << "  wax     : 30 EUR / pack -> +25 wax\n";
-    std::cout << "Cumperi cu: buysupplies <water|shampoo|wax> [packs]\n";
+    out() << "=== SUPPLY SHOP ===\n";
+    out() << "Ai: " << std::fixed << std::setprecision(2) << cash_ << " EUR\n";
+    out() << "Inventar curent: " << inv_ << "\n\n";
+    out() << "Oferte:\n";
+    out() << "  water   : 20 EUR / pack -> +200 water\n";
+    out() << "  shampoo : 25 EUR / pack -> +50 shampoo\n";
+    out() << "  wax     : 30 EUR / pack -> +25 wax\n";
+    out() << "Cumperi cu: buysupplies <water|shampoo|wax> [packs]\n";
 }
 
 /**
@@ -508,6 +757,7 @@ void CarWash::buySupplies(const std::string &item, int packs) {
         inv_.addWater(kWaterPackQty * packs);
         totalSuppliesPacksBought_ += packs;
         achievements_.onBuySupplies(*this, "water", packs, totalCost);
+        journalPurchase(SupplyItem::Water, packs, totalCost);
         logEvent("Cumparare supplies: water x" + std::to_string(packs));
     } else if (sameCaseInsensitive(item, "shampoo")) {
         const double totalCost = kShampooPackCost * packs;
@@ -516,6 +766,7 @@ void CarWash::buySupplies(const std::string &item, int packs) {
         inv_.addShampoo(kShampooPackQty * packs);
         totalSuppliesPacksBought_ += packs;
         achievements_.onBuySupplies(*this, "shampoo", packs, totalCost);
+        journalPurchase(SupplyItem::Shampoo, packs, totalCost);
         logEvent("Cumparare supplies: shampoo x" + std::to_string(packs));
     } else if (sameCaseInsensitive(item, "wax")) {
         const double totalCost = kWaxPackCost * packs;
@@ -524,6 +775,7 @@ void CarWash::buySupplies(const std::string &item, int packs) {
         inv_.addWax(kWaxPackQty * packs);
         totalSuppliesPacksBought_ += packs;
         achievements_.onBuySupplies(*this, "wax", packs, totalCost);
+        journalPurchase(SupplyItem::Wax, packs, totalCost);
         logEvent("Cumparare supplies: wax x" + std::to_string(packs));
     } else {
         throw InvalidCommandException("Resursa necunoscuta. Folosire: buysupplies <water|shampoo|wax> [packs]");
@@ -534,22 +786,296 @@ void CarWash::buySupplies(const std::string &item, int packs) {
  * @brief Prints achievements status.
  */
 void CarWash::showAchievements() const {
-    achievements_.print(std::cout);
+    achievements_.print(out());
+}
+
+std::unique_ptr<CarWash> CarWash::fork() const {
+    std::unique_ptr<CarWash> copy(new CarWash(*this));
+    copy->out_ = nullptr;
+    copy->recorder_ = nullptr;
+    copy->sandbox_ = nullptr;
+    copy->journal_ = nullptr;
+    copy->exporter_ = nullptr;
+    return copy;
+}
+
+std::vector<WhatIfBranch> CarWash::whatIf(const std::vector<WhatIfOption> &options, int days, int threads) const {
+    std::vector<WhatIfBranch> branches(options.size());
+    const size_t firstDay = reports_->size();
+    ThreadPool pool(threads);
+
+    pool.parallelFor(static_cast<int>(options.size()), [&](int i) {
+        const WhatIfOption &opt = options[static_cast<size_t>(i)];
+        WhatIfBranch &b = branches[static_cast<size_t>(i)];
+        b.label = opt.label;
+        try {
+            auto branch = fork();
+            if (opt.upgradeId > 0) branch->buyUpgrade(opt.upgradeId);
+            if (!opt.pricing.empty()) branch->setPricingMode(opt.pricing);
+            branch->runDays(days);
+
+            b.projected = Statistics(branch->reports_->slice(firstDay));
+            b.finalCash = branch->cash_;
+        } catch (const CarWashException &ex) {
+            b.feasible = false;
+            b.error = ex.what();
+        }
+    });
+    return branches;
+}
+
+/**
+ * @brief Prints one line per candidate action with its projected results.
+ *
+ * @param days Days simulated per branch.
+ */
+void CarWash::showWhatIf(int days) const {
+    std::vector<WhatIfOption> options;
+    options.push_back({"fara schimbari", 0, ""});
+    for (int id = 1; id <= 4; ++id) {
+        options.push_back({"upgrade " + Upgrade::create(id)->name(), id, ""});
+    }
+    for (const char *mode: {"aggressive", "balanced", "conservative"}) {
+        if (pricing_->name() != mode) options.push_back({std::string("pricing ") + mode, 0, mode});
+    }
+
+    out() << "=== WHAT-IF (" << days << " zile) ===\n";
+    for (const WhatIfBranch &b: whatIf(options, days)) {
+        out() << "  " << std::left << std::setw(28) << b.label << std::right;
+        if (!b.feasible) {
+            out() << " indisponibil: " << b.error << "\n";
+            continue;
+        }
+        out() << std::fixed << std::setprecision(2)
+                << " masini=" << b.projected.totalCars()
+                << " pierduti=" << b.projected.totalLost()
+                << " venit=" << b.projected.totalRevenue()
+                << " satisfactie=" << b.projected.avgSatisfactionWeighted()
+                << " cash final=" << b.finalCash << "\n";
+    }
 }
 
 /**
  * @brief Prints analytics computed from stored daily reports.
  */
 void CarWash::showStats() const {
-    Statistics stats(reports_);
-    stats.print(std::cout);
+    statistics().print(out());
+}
+
+/**
+ * @brief Serializes the complete simulation state (see CarWash.h for the coverage).
+ *
+ * Field order is the file format; any change must bump SAVE_VERSION.
+ *
+ * @param w Destination buffer.
+ */
+void CarWash::saveState(BinaryWriter &w, const HistoryLog *history) const {
+    w.u32(SAVE_MAGIC);
+    w.u32(SAVE_VERSION);
+
+    w.str(name_);
+    w.i32(openMin_);
+    w.i32(closeMin_);
+    w.i32(nowMin_);
+    w.i32(day_);
+    w.f64(cash_);
+    inv_.save(w);
+
+    w.u32(static_cast<std::uint32_t>(services_.size()));
+    for (const auto &s: services_) s->save(w);
+    w.u32(static_cast<std::uint32_t>(bays_.size()));
+    for (const auto &b: bays_) b.save(w);
+
+    queue_.save(w);
+    demand_.save(w);
+    goals_.save(w);
+    w.u32(static_cast<std::uint32_t>(purchased_.size()));
+    for (const auto &u: purchased_) w.i32(u->id());
+    events_.save(w);
+    reputation_.save(w);
+    w.str(pricing_->name());
+    achievements_.save(w);
+
+    w.i32(totalCarsServed_);
+    w.f64(totalSatisfaction_);
+    w.i32(totalSatisfiedCustomers_);
+    w.i32(dailyCarsServed_);
+    w.f64(dailySatisfactionSum_);
+    w.i32(dailySatisfiedCustomers_);
+    w.i32(dailyLost_);
+    w.f64(dailyRevenue_);
+
+    currentReport_.save(w);
+    w.boolean(history != nullptr);
+    if (history) {
+        reports_->saveLayout(w);
+        w.str(std::filesystem::path(history->path()).filename().string());
+        w.u64(history->id());
+        w.u64(history->rows());
+        w.u64(history->bytes());
+    } else {
+        reports_->save(w);
+    }
+    streaming_.save(w);
+
+    w.f64(speedFactor_);
+    w.f64(comfortBonus_);
+    w.i32(baseDemandBonus_);
+    w.i32(sharedDemandBonus_);
+    w.i32(totalSuppliesPacksBought_);
+    w.i32(upgradesBought_);
+    w.boolean(nanoCoatingEnabled_);
+
+    sim_.save(w);
+    for (const Rng *g: {&rng_.arrivals, &rng_.customers, &rng_.events}) {
+        for (std::uint64_t word: g->state()) w.u64(word);
+    }
+}
+
+/**
+ * @brief Rebuilds a simulation from a snapshot.
+ *
+ * Services and bays are attached directly (not through addService/addBay), so no
+ * achievement rewards or parity capabilities are applied a second time.
+ *
+ * @param r Snapshot reader positioned at the magic number.
+ * @return Headless restored instance.
+ * @throws SaveFileException If the snapshot is invalid.
+ */
+std::unique_ptr<CarWash> CarWash::restoreState(BinaryReader &r, const std::string &dir) {
+    if (r.u32() != SAVE_MAGIC) throw SaveFileException("Fisierul nu este o salvare CarWash");
+    const std::uint32_t version = r.u32();
+    if (version != SAVE_VERSION) {
+        throw SaveFileException("Versiune de salvare nesuportata: " + std::to_string(version));
+    }
+
+    std::string name = r.str();
+    const int open = r.i32();
+    const int close = r.i32();
+    if (open < 0 || open >= close || close > 24 * 60) throw SaveFileException("Program invalid in salvare");
+
+    auto cw = std::make_unique<CarWash>(std::move(name), Inventory(), open, close);
+    cw->out_ = nullptr;
+    cw->nowMin_ = r.i32();
+    cw->day_ = r.i32();
+    cw->cash_ = r.f64();
+    cw->inv_.load(r);
+
+    const size_t services = r.count(1);
+    if (services > MAX_SERV) throw SaveFileException("Prea multe servicii in salvare");
+    for (size_t i = 0; i < services; ++i) cw->attachService(ServiceFactory::load(r));
+    const size_t bays = r.count(1);
+    if (bays > MAX_BAYS) throw SaveFileException("Prea multe boxe in salvare");
+    for (size_t i = 0; i < bays; ++i) cw->attachBay(WashBay::load(r));
+
+    cw->queue_.load(r);
+    cw->demand_.load(r);
+    cw->goals_.load(r);
+    const size_t upgrades = r.count(4);
+    for (size_t i = 0; i < upgrades; ++i) {
+        auto u = Upgrade::create(r.i32());
+        if (!u) throw SaveFileException("Upgrade necunoscut in salvare");
+        cw->purchased_.push_back(std::move(u));
+    }
+    cw->events_.load(r);
+    cw->reputation_.load(r);
+    cw->pricing_ = makePricing(r.str());
+    cw->achievements_.load(r);
+
+    cw->totalCarsServed_ = r.i32();
+    cw->totalSatisfaction_ = r.f64();
+    cw->totalSatisfiedCustomers_ = r.i32();
+    cw->dailyCarsServed_ = r.i32();
+    cw->dailySatisfactionSum_ = r.f64();
+    cw->dailySatisfiedCustomers_ = r.i32();
+    cw->dailyLost_ = r.i32();
+    cw->dailyRevenue_ = r.f64();
+
+    cw->currentReport_.load(r);
+    if (r.boolean()) {
+        // checkpoint: randurile istoricului sunt in jurnalul de langa salvare
+        cw->reports_->loadLayout(r);
+        const std::string file = r.str();
+        const std::uint64_t id = r.u64();
+        const std::uint64_t rows = r.u64();
+        const std::uint64_t bytes = r.u64();
+        HistoryLog::read((std::filesystem::path(dir) / file).string(), id, rows, bytes, *cw->reports_);
+    } else {
+        cw->reports_->load(r);
+    }
+    cw->stats_ = StatsAggregator(*cw->reports_);
+    cw->streaming_.load(r);
+
+    cw->speedFactor_ = r.f64();
+    cw->comfortBonus_ = r.f64();
+    cw->baseDemandBonus_ = r.i32();
+    cw->sharedDemandBonus_ = r.i32();
+    cw->totalSuppliesPacksBought_ = r.i32();
+    cw->upgradesBought_ = r.i32();
+    cw->nanoCoatingEnabled_ = r.boolean();
+
+    cw->sim_.load(r);
+    for (Rng *g: {&cw->rng_.arrivals, &cw->rng_.customers, &cw->rng_.events}) {
+        std::array<std::uint64_t, 4> s{};
+        for (auto &word: s) word = r.u64();
+        g->setState(s);
+    }
+    if (!r.atEnd()) throw SaveFileException("Date suplimentare la finalul salvarii");
+    return cw;
+}
+
+void CarWash::save(const std::string &path) const {
+    BinaryWriter w;
+    saveState(w);
+    if (sandbox_) sandbox_->store(path, w);
+    else w.writeFile(path);
+}
+
+void CarWash::checkpoint(const std::string &path, HistoryLog &history) const {
+    history.append(*reports_);
+    BinaryWriter w;
+    saveState(w, &history);
+    w.writeFile(path);
+}
+
+void CarWash::load(const std::string &path) {
+    BinaryReader r = sandbox_ ? sandbox_->open(path) : BinaryReader::fromFile(path);
+    std::unique_ptr<CarWash> restored = restoreState(r, std::filesystem::path(path).parent_path().string());
+    // the replay gets the loaded state from the log, not from the file
+    if (recorder_) recorder_->loaded(*restored);
+    std::ostream *out = out_;
+    ReplayRecorder *recorder = recorder_;
+    ReplaySandbox *sandbox = sandbox_;
+    EventJournal *journal = journal_;
+    ReportExporter *exporter = exporter_;
+    *this = std::move(*restored);
+    out_ = out;
+    recorder_ = recorder;
+    sandbox_ = sandbox;
+    journal_ = journal;
+    exporter_ = exporter;
+}
+
+std::uint64_t CarWash::stateDigest() const {
+    BinaryWriter w;
+    saveState(w);
+    return w.digest();
+}
+
+/**
+ * @brief Prints the aggregate analytics without the per-day series.
+ *
+ * @param os Output stream.
+ */
+void CarWash::printSummary(std::ostream &os) const {
+    statistics().printSummary(os);
 }
 
 /**
  * @brief Prints the available command list and their usage.
  */
 void CarWash::showHelp() const {
-    std::cout
+    out()
             << "Comenzi:\n"
             << "  help           - afiseaza acest mesaj\n"
             << "  status         - stare detaliata\n"
@@ -569,6 +1095,9 @@ void CarWash::showHelp() const {
             << "  buysupplies R [packs] - cumpara supplies (water/shampoo/wax)\n"
             << "  achievements   - lista achievements\n"
             << "  stats          - analytics detaliat\n"
+            << "  whatif [zile]  - compara upgrade-urile si strategiile de pret pe urmatoarele zile\n"
+            << "  save [fisier]  - salveaza simularea (implicit carwash.sav)\n"
+            << "  load [fisier]  - incarca o simulare salvata\n"
             << "  endrun         - termina simularea\n";
 }
 
@@ -584,12 +1113,8 @@ void CarWash::showHelp() const {
  * @throws CarWashException If there is not enough cash.
  */
 void CarWash::buyUpgrade(int id) {
-    std::unique_ptr<Upgrade> u;
-    if (id == 1) u = std::make_unique<BaySpeedUpgrade>();
-    else if (id == 2) u = std::make_unique<ComfortUpgrade>();
-    else if (id == 3) u = std::make_unique<MarketingUpgrade>();
-    else if (id == 4) u = std::make_unique<NanoCoatingUpgrade>();
-    else throw InvalidCommandException("Upgrade necunoscut");
+    std::shared_ptr<const Upgrade> u = Upgrade::create(id);
+    if (!u) throw InvalidCommandException("Upgrade necunoscut");
 
     if (u->cost() > cash_) throw CarWashException("Nu ai suficienti bani pentru upgrade");
 
@@ -599,6 +1124,13 @@ void CarWash::buyUpgrade(int id) {
     purchased_.push_back(std::move(u));
     upgradesBought_ += 1;
     achievements_.onBuyUpgrade(*this, id, cost);
+    if (journal_) {
+        JournalRecord r;
+        r.type = JournalType::BuyUpgrade;
+        r.subject = static_cast<std::uint8_t>(id);
+        r.amount = cost;
+        journal(r);
+    }
 }
 
 /**
@@ -607,7 +1139,91 @@ void CarWash::buyUpgrade(int id) {
  * @param msg Message text to log.
  */
 void CarWash::logEvent(const std::string &msg) const {
-    std::cout << "[LOG] " << msg << "\n";
+    if (out_) *out_ << "[LOG] " << msg << "\n";
+}
+
+/**
+ * @brief Parses and executes one interactive command line.
+ *
+ * @param line Raw command line (as typed).
+ * @return false if the command ends the session (endrun); true otherwise.
+ * @throws CarWashException If the command is invalid or rejected by the simulation.
+ */
+bool CarWash::executeCommand(const std::string &line) {
+    std::istringstream iss(line);
+    std::string cmd;
+    iss >> cmd;
+
+    if (cmd == "help") showHelp();
+    else if (cmd == "status") showStatus();
+    else if (cmd == "services") showServices();
+    else if (cmd == "bays") showBays();
+    else if (cmd == "queue") showQueue();
+    else if (cmd == "next") nextCommand();
+    else if (cmd == "endday") {
+        runUntil(closeMin_);
+        showDashboard();
+    } else if (cmd == "dashboard") showDashboard();
+    else if (cmd == "goals") showGoals();
+    else if (cmd == "upgrades") showUpgrades();
+    else if (cmd == "achievements") showAchievements();
+    else if (cmd == "stats") showStats();
+    else if (cmd == "buyupgrade") {
+        int uid = 0;
+        iss >> uid;
+        if (uid <= 0) throw InvalidCommandException("Folosire: buyupgrade <id>");
+        buyUpgrade(uid);
+        showDashboard();
+    } else if (cmd == "setpricing") {
+        std::string mode;
+        iss >> mode;
+        if (mode.empty())
+            throw InvalidCommandException(
+                "Folosire: setpricing <aggressive|balanced|conservative>");
+        setPricingMode(mode);
+    } else if (cmd == "reports") showReports();
+    else if (cmd == "events") events_.print(out());
+    else if (cmd == "shop") showShop();
+    else if (cmd == "buysupplies") {
+        std::string item, packsStr;
+        iss >> item >> packsStr;
+        if (item.empty()) throw InvalidCommandException("Folosire: buysupplies <water|shampoo|wax> [packs]");
+        int packs = 1;
+        if (!packsStr.empty()) {
+            size_t pos = 0;
+            packs = std::stoi(packsStr, &pos);
+            if (pos != packsStr.size())
+                throw InvalidCommandException(
+                    "Folosire: buysupplies <water|shampoo|wax> [packs]");
+        }
+        buySupplies(item, packs);
+        showDashboard();
+    } else if (cmd == "whatif") {
+        std::string daysStr;
+        iss >> daysStr;
+        int days = 3;
+        if (!daysStr.empty()) {
+            size_t pos = 0;
+            days = std::stoi(daysStr, &pos);
+            if (pos != daysStr.size() || days <= 0) throw InvalidCommandException("Folosire: whatif [zile]");
+        }
+        showWhatIf(days);
+    } else if (cmd == "save" || cmd == "load") {
+        std::string path;
+        iss >> path;
+        if (path.empty()) path = "carwash.sav";
+        if (cmd == "save") {
+            save(path);
+            out() << "Simulare salvata in " << path << "\n";
+        } else {
+            load(path);
+            out() << "Simulare incarcata din " << path << "\n";
+            showDashboard();
+        }
+    } else if (cmd == "endrun") return false;
+    else if (cmd.empty()) return true;
+    else throw InvalidCommandException("Comanda necunoscuta: " + cmd);
+    return true;
 }
 
 /**
@@ -618,7 +1234,7 @@ void CarWash::logEvent(const std::string &msg) const {
  * commands from stdin and executes them until 'endrun' or EOF.
  */
 void CarWash::run() {
-    std::cout << "=== CARWASH TYCOON ===\n";
+    out() << "=== CARWASH TYCOON ===\n";
     showHelp();
     showDashboard();
 
@@ -639,81 +1255,39 @@ void CarWash::run() {
 
         buyUpgrade(4);
         showServices();
+        bookCars("Basic", 1);
 
         setPricingMode("balanced");
+        save("ci.sav");
+        nextCommand();
+        load("ci.sav");
         nextCommand();
+        showWhatIf(2);
 
         showReports();
         showAchievements();
         showStats();
         showDashboard();
     } catch (const CarWashException &ex) {
-        std::cout << "Eroare: " << ex.what() << "\n";
+        out() << "Eroare: " << ex.what() << "\n";
     }
-    std::cout << "=== FINAL (CI) ===\n";
+    out() << "=== FINAL (CI) ===\n";
 #else
     std::string line;
     while (true) {
-        std::cout << "> ";
+        out() << "> ";
         if (!std::getline(std::cin, line)) break;
 
         try {
-            std::istringstream iss(line);
-            std::string cmd;
-            iss >> cmd;
-
-            if (cmd == "help") showHelp();
-            else if (cmd == "status") showStatus();
-            else if (cmd == "services") showServices();
-            else if (cmd == "bays") showBays();
-            else if (cmd == "queue") showQueue();
-            else if (cmd == "next") nextCommand();
-            else if (cmd == "endday") {
-                endCurrentDay();
-                showDashboard();
-            } else if (cmd == "dashboard") showDashboard();
-            else if (cmd == "goals") showGoals();
-            else if (cmd == "upgrades") showUpgrades();
-            else if (cmd == "achievements") showAchievements();
-            else if (cmd == "stats") showStats();
-            else if (cmd == "buyupgrade") {
-                int uid = 0;
-                iss >> uid;
-                if (uid <= 0) throw InvalidCommandException("Folosire: buyupgrade <id>");
-                buyUpgrade(uid);
-                showDashboard();
-            } else if (cmd == "setpricing") {
-                std::string mode;
-                iss >> mode;
-                if (mode.empty())
-                    throw InvalidCommandException(
-                        "Folosire: setpricing <aggressive|balanced|conservative>");
-                setPricingMode(mode);
-            } else if (cmd == "reports") showReports();
-            else if (cmd == "events") events_.print(std::cout);
-            else if (cmd == "shop") showShop();
-            else if (cmd == "buysupplies") {
-                std::string item, packsStr;
-                iss >> item >> packsStr;
-                if (item.empty()) throw InvalidCommandException("Folosire: buysupplies <water|shampoo|wax> [packs]");
-                int packs = 1;
-                if (!packsStr.empty()) {
-                    size_t pos = 0;
-                    packs = std::stoi(packsStr, &pos);
-                    if (pos != packsStr.size())
-                        throw InvalidCommandException(
-                            "Folosire: buysupplies <water|shampoo|wax> [packs]");
-                }
-                buySupplies(item, packs);
-                showDashboard();
-            } else if (cmd == "endrun") break;
-            else if (cmd.empty()) continue;
-            else throw InvalidCommandException("Comanda necunoscuta: " + cmd);
+            if (recorder_ && line.find_first_not_of(" \t\r") != std::string::npos) {
+                recorder_->record(day_, nowMin_, line);
+            }
+            if (!executeCommand(line)) break;
         } catch (const CarWashException &ex) {
-            std::cout << "Eroare: " << ex.what() << "\n";
+            out() << "Eroare: " << ex.what() << "\n";
         }
     }
-    std::cout << "=== FINAL ===\n";
+    out() << "=== FINAL ===\n";
     showDashboard();
 #endif
 }
@@ -0,0 +1,114 @@
+#include "../headers/CarWashNetwork.h"
+#include "../headers/CarWash.h"
+#include "../headers/CarWashExceptions.h"
+#include "../headers/Rng.h"
+#include "../headers/Scenario.h"
+
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+
+CarWashNetwork::CarWashNetwork(const Scenario &scenario, int sites, std::uint64_t baseSeed, int threads)
+    : pool_(threads) {
+    if (sites <= 0) throw CarWashException("Reteaua trebuie sa aiba cel putin o locatie");
+    sites_.resize(static_cast<size_t>(sites));
+    pool_.parallelFor(sites, [&](int i) {
+        auto site = scenario.build(nullptr);
+        site->seed(deriveSeed(baseSeed, static_cast<std::uint64_t>(i)));
+        sites_[static_cast<size_t>(i)] = std::move(site);
+    });
+}
+
+CarWashNetwork::~CarWashNetwork() = default;
+
+void CarWashNetwork::stepSites(const std::vector<int> &ids) {
+    pool_.parallelFor(static_cast<int>(ids.size()), [&](int k) {
+        sites_[static_cast<size_t>(ids[static_cast<size_t>(k)])]->simulateHour();
+    });
+    applyChainEffects();
+    collectFinishedDays();
+}
+
+void CarWashNetwork::stepHour() {
+    std::vector<int> ids(sites_.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<int>(i);
+    stepSites(ids);
+}
+
+void CarWashNetwork::stepDay() {
+    const size_t target = chainReports_->size() + 1;
+    std::vector<int> lagging;
+    while (chainReports_->size() < target) {
+        lagging.clear();
+        for (size_t i = 0; i < sites_.size(); ++i) {
+            if (sites_[i]->reports().size() < target) lagging.push_back(static_cast<int>(i));
+        }
+        stepSites(lagging);
+    }
+}
+
+void CarWashNetwork::runDays(int days) {
+    for (int d = 0; d < days; ++d) stepDay();
+}
+
+void CarWashNetwork::applyChainEffects() {
+    const auto n = static_cast<double>(sites_.size());
+
+    int totalMarketing = 0;
+    double totalReputation = 0.0;
+    for (const auto &s: sites_) {
+        totalMarketing += s->marketingBonus();
+        totalReputation += s->reputationScore();
+    }
+
+    const double chainReputation = totalReputation / n;
+    for (const auto &s: sites_) {
+        const double others = n > 1.0 ? (totalMarketing - s->marketingBonus()) / (n - 1.0) : 0.0;
+        s->setSharedDemandBonus(static_cast<int>(std::lround(marketingSpill_ * others)));
+        s->blendReputation(chainReputation, reputationBlend_);
+    }
+}
+
+void CarWashNetwork::collectFinishedDays() {
+    while (true) {
+        const size_t day = chainReports_->size();
+        for (const auto &s: sites_) {
+            if (s->reports().size() <= day) return;
+        }
+        DailyReport chain = sites_.front()->reports().at(day);
+        for (size_t i = 1; i < sites_.size(); ++i) chain.merge(sites_[i]->reports().at(day));
+        if (chainReports_.use_count() > 1) chainReports_ = std::make_shared<ReportHistory>(*chainReports_);
+        chainReports_->append(chain);
+        chainStats_.add(*chainReports_, day);
+        chainStreaming_.addDay(chain.totalRevenue(), chain.lostCustomers(), chain.avgSatisfaction());
+    }
+}
+
+double CarWashNetwork::totalCash() const noexcept {
+    double sum = 0.0;
+    for (const auto &s: sites_) sum += s->totalCash();
+    return sum;
+}
+
+double CarWashNetwork::averageReputation() const noexcept {
+    double sum = 0.0;
+    for (const auto &s: sites_) sum += s->reputationScore();
+    return sum / static_cast<double>(sites_.size());
+}
+
+void CarWashNetwork::printSummary(std::ostream &os) const {
+    size_t best = 0;
+    size_t worst = 0;
+    for (size_t i = 1; i < sites_.size(); ++i) {
+        if (sites_[i]->totalCash() > sites_[best]->totalCash()) best = i;
+        if (sites_[i]->totalCash() < sites_[worst]->totalCash()) worst = i;
+    }
+
+    statistics().printSummary(os);
+    os << std::fixed << std::setprecision(2);
+    os << "Locatii: " << sites_.size()
+            << " | Cash total: " << totalCash() << " EUR"
+            << " | Reputatie medie: " << averageReputation() << "\n";
+    os << "Cea mai buna locatie: #" << best + 1 << " (" << sites_[best]->totalCash() << " EUR)"
+            << " | Cea mai slaba: #" << worst + 1 << " (" << sites_[worst]->totalCash() << " EUR)\n";
+}
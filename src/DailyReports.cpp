@@ -1,21 +1,39 @@
 #include "../headers/DailyReport.h"
+#include "../headers/BinaryIO.h"
 
+#include <algorithm>
 #include <ostream>
 #include <iomanip>
 
+namespace {
+    /**
+     * @brief Keys of the services that sold anything, ordered by name (the old map order).
+     */
+    std::vector<ServiceKey> soldByName(const std::vector<ServiceStats> &stats, const ServiceKeys &keys) {
+        std::vector<ServiceKey> sold;
+        for (size_t k = 0; k < stats.size(); ++k) {
+            if (stats[k].cars != 0) sold.push_back(static_cast<ServiceKey>(k));
+        }
+        std::sort(sold.begin(), sold.end(), [&keys](ServiceKey a, ServiceKey b) {
+            return keys.name(a) < keys.name(b);
+        });
+        return sold;
+    }
+} // namespace
+
 void DailyReport::beginDay(int day) {
     day_ = day;
     totalCars_ = 0;
     lostCustomers_ = 0;
     totalRevenue_ = 0.0;
     avgSatisfaction_ = 0.0;
-    perService_.clear();
+    std::fill(perService_.begin(), perService_.end(), ServiceStats{});
 }
 
-void DailyReport::addServiceSale(const std::string &name, double price) {
-    ServiceStats &st = perService_[name];
-    st.cars += 1;
-    st.revenue += price;
+void DailyReport::addServiceStats(ServiceKey key, const ServiceStats &st) {
+    if (key >= perService_.size()) perService_.resize(static_cast<size_t>(key) + 1);
+    perService_[key].cars += st.cars;
+    perService_[key].revenue += st.revenue;
 }
 
 void DailyReport::finalize(int totalCars, int lost, double avgSat, double totalRevenue) {
@@ -25,6 +43,36 @@ void DailyReport::finalize(int totalCars, int lost, double avgSat, double totalR
     totalRevenue_ = totalRevenue;
 }
 
+void DailyReport::merge(const DailyReport &other) {
+    const int cars = totalCars_ + other.totalCars_;
+    avgSatisfaction_ = cars > 0
+                           ? (avgSatisfaction_ * totalCars_ + other.avgSatisfaction_ * other.totalCars_) / cars
+                           : 0.0;
+    totalCars_ = cars;
+    lostCustomers_ += other.lostCustomers_;
+    totalRevenue_ += other.totalRevenue_;
+
+    if (other.keys_ == keys_) {
+        for (size_t k = 0; k < other.perService_.size(); ++k) {
+            addServiceStats(static_cast<ServiceKey>(k), other.perService_[k]);
+        }
+        return;
+    }
+    std::shared_ptr<ServiceKeys> extended;
+    for (size_t k = 0; k < other.perService_.size(); ++k) {
+        const ServiceStats &st = other.perService_[k];
+        if (st.cars == 0 && st.revenue == 0.0) continue;
+        const std::string &name = other.keys_->name(static_cast<ServiceKey>(k));
+        int mine = (extended ? static_cast<const ServiceKeys &>(*extended) : *keys_).find(name);
+        if (mine < 0) {
+            if (!extended) extended = std::make_shared<ServiceKeys>(*keys_);
+            mine = extended->intern(name);
+        }
+        addServiceStats(static_cast<ServiceKey>(mine), st);
+    }
+    if (extended) keys_ = std::move(extended);
+}
+
 void DailyReport::print(std::ostream &os) const {
     os << "Raport ziua " << day_ << ":\n";
     os << "  Masini spalate: " << totalCars_ << "\n";
@@ -34,18 +82,54 @@ void DailyReport::print(std::ostream &os) const {
     os << "  Satisfactie medie: " << std::setprecision(2)
             << avgSatisfaction_ << "\n";
 
-    if (perService_.empty()) {
+    const std::vector<ServiceKey> sold = soldByName(perService_, *keys_);
+    if (sold.empty()) {
         os << "  (fara servicii inregistrate)\n";
     } else {
         os << "  Detaliu pe servicii:\n";
-        for (const auto &[name, st]: perService_) {
-            os << "    - " << name << ": " << st.cars
+        for (ServiceKey k: sold) {
+            const ServiceStats &st = perService_[k];
+            os << "    - " << keys_->name(k) << ": " << st.cars
                     << " masini, venit " << std::fixed << std::setprecision(2)
                     << st.revenue << " EUR\n";
         }
     }
 }
 
+void DailyReport::save(BinaryWriter &w) const {
+    w.i32(day_);
+    w.i32(totalCars_);
+    w.i32(lostCustomers_);
+    w.f64(totalRevenue_);
+    w.f64(avgSatisfaction_);
+    const std::vector<ServiceKey> sold = soldByName(perService_, *keys_);
+    w.u32(static_cast<std::uint32_t>(sold.size()));
+    for (ServiceKey k: sold) {
+        w.str(keys_->name(k));
+        w.i32(perService_[k].cars);
+        w.f64(perService_[k].revenue);
+    }
+}
+
+void DailyReport::load(BinaryReader &r) {
+    day_ = r.i32();
+    totalCars_ = r.i32();
+    lostCustomers_ = r.i32();
+    totalRevenue_ = r.f64();
+    avgSatisfaction_ = r.f64();
+    perService_.clear();
+    const size_t n = r.count(16);
+    for (size_t i = 0; i < n; ++i) {
+        const std::string name = r.str();
+        ServiceStats st;
+        st.cars = r.i32();
+        st.revenue = r.f64();
+        const int key = keys_->find(name);
+        if (key < 0) throw SaveFileException("Serviciu necunoscut in raport: " + name);
+        addServiceStats(static_cast<ServiceKey>(key), st);
+    }
+}
+
 std::ostream &operator<<(std::ostream &os, const DailyReport &rep) {
     rep.print(os);
     return os;
@@ -0,0 +1,125 @@
+#include "../headers/EventJournal.h"
+#include "../headers/CarWashExceptions.h"
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file EventJournal.cpp
+ * @brief Segment management of the gameplay journal (mmap on POSIX, buffered elsewhere).
+ */
+
+namespace {
+    /**
+     * @brief First 32 bytes of every segment.
+     */
+    struct SegmentHeader {
+        std::uint32_t magic{EventJournal::MAGIC};
+        std::uint16_t version{EventJournal::VERSION};
+        std::uint16_t recordSize{sizeof(JournalRecord)};
+        std::uint32_t segment{0};
+        std::uint8_t reserved[20]{};
+    };
+
+    static_assert(sizeof(SegmentHeader) == sizeof(JournalRecord));
+} // namespace
+
+EventJournal::EventJournal(std::string base, std::size_t segmentBytes)
+    : base_(std::move(base)),
+      capacity_(segmentBytes / sizeof(JournalRecord) > 1 ? segmentBytes / sizeof(JournalRecord) - 1 : 1) {
+    // drop the later segments of an older journal with the same prefix, so readers see one run
+    for (std::uint32_t i = 1; std::remove(segmentPath(i).c_str()) == 0; ++i) {
+    }
+    openSegment();
+}
+
+EventJournal::~EventJournal() {
+    try {
+        closeSegment();
+    } catch (...) {
+        // destructor must not throw; the data already written stays on disk
+    }
+}
+
+std::string EventJournal::segmentPath(std::uint32_t index) const {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%06u.jrn", index);
+    return base_ + suffix;
+}
+
+#if defined(_WIN32)
+
+void EventJournal::openSegment() {
+    mapBytes_ = (capacity_ + 1) * sizeof(JournalRecord);
+    map_ = ::operator new(mapBytes_);
+    std::memset(map_, 0, mapBytes_);
+    SegmentHeader header;
+    header.segment = segment_;
+    std::memcpy(map_, &header, sizeof(header));
+    records_ = static_cast<JournalRecord *>(map_) + 1;
+    next_ = records_;
+    end_ = records_ + capacity_;
+}
+
+void EventJournal::closeSegment() {
+    if (!map_) return;
+    const auto used = static_cast<std::size_t>(next_ - records_ + 1) * sizeof(JournalRecord);
+    std::ofstream f(segmentPath(segment_), std::ios::binary | std::ios::trunc);
+    f.write(static_cast<const char *>(map_), static_cast<std::streamsize>(used));
+    ::operator delete(map_);
+    map_ = nullptr;
+    records_ = next_ = end_ = nullptr;
+    if (!f) throw JournalException("Nu pot scrie jurnalul: " + segmentPath(segment_));
+}
+
+#else
+
+void EventJournal::openSegment() {
+    const std::string path = segmentPath(segment_);
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) throw JournalException("Nu pot crea jurnalul: " + path);
+
+    mapBytes_ = (capacity_ + 1) * sizeof(JournalRecord);
+    if (::ftruncate(fd_, static_cast<off_t>(mapBytes_)) != 0) {
+        ::close(fd_);
+        fd_ = -1;
+        throw JournalException("Nu pot aloca jurnalul: " + path);
+    }
+    map_ = ::mmap(nullptr, mapBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (map_ == MAP_FAILED) {
+        map_ = nullptr;
+        ::close(fd_);
+        fd_ = -1;
+        throw JournalException("Nu pot mapa jurnalul: " + path);
+    }
+
+    SegmentHeader header;
+    header.segment = segment_;
+    std::memcpy(map_, &header, sizeof(header));
+    records_ = static_cast<JournalRecord *>(map_) + 1;
+    next_ = records_;
+    end_ = records_ + capacity_;
+}
+
+void EventJournal::closeSegment() {
+    if (!map_) return;
+    const auto used = static_cast<off_t>(next_ - records_ + 1) * static_cast<off_t>(sizeof(JournalRecord));
+    ::munmap(map_, mapBytes_);
+    map_ = nullptr;
+    records_ = next_ = end_ = nullptr;
+    const bool trimmed = ::ftruncate(fd_, used) == 0;
+    ::close(fd_);
+    fd_ = -1;
+    if (!trimmed) throw JournalException("Nu pot finaliza jurnalul: " + segmentPath(segment_));
+}
+
+#endif
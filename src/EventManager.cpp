@@ -1,28 +1,43 @@
 #include "../headers/EventManager.h"
 #include "../headers/CarWash.h"
+#include "../headers/BinaryIO.h"
 
-#include <cstdlib>
-#include <ctime>
 #include <ostream>
 
+namespace {
+    // echivalentul lui (std::rand() % 100) / 100.0
+    double roll(Rng &rng) {
+        return rng.uniformInt(0, 99) / 100.0;
+    }
+
+    // codul evenimentului (salvari, jurnal): 0 vreme, 1 sarbatoare, 2 inspectie, -1 necunoscut
+    int eventKind(const Event &e, double &value) {
+        value = 0.0;
+        if (const auto *we = dynamic_cast<const WeatherEvent *>(&e)) {
+            value = we->intensity();
+            return 0;
+        }
+        if (dynamic_cast<const HolidayEvent *>(&e)) return 1;
+        if (const auto *ie = dynamic_cast<const InspectionEvent *>(&e)) {
+            value = ie->severity();
+            return 2;
+        }
+        return -1;
+    }
+}
+
 void EventManager::clear() {
     todays_.clear();
 }
 
-void EventManager::generateForNewDay(const CarWash &wash) {
+void EventManager::generateForNewDay(const CarWash &wash, Rng &rng) {
     if (todays_.empty()) {
-        static bool seeded = false;
-        if (!seeded) {
-            std::srand(static_cast<unsigned>(std::time(nullptr)));
-            seeded = true;
-        }
-
         double rep = wash.reputationScore(); // 0..5 aproximativ
-        double r = (std::rand() % 100) / 100.0;
+        double r = roll(rng);
 
         // sanse de evenimente in functie de reputatie
         if (r < 0.4) {
-            double intensity = (std::rand() % 100) / 100.0;
+            double intensity = roll(rng);
             todays_.push_back(std::make_unique<WeatherEvent>(intensity));
         }
         if (r > 0.6) {
@@ -30,9 +45,9 @@ void EventManager::generateForNewDay(const CarWash &wash) {
         }
         // reputatie mica => sanse mai mari de inspectie
         double inspProb = rep < 3.5 ? 0.5 : 0.2;
-        double r2 = (std::rand() % 100) / 100.0;
+        double r2 = roll(rng);
         if (r2 < inspProb) {
-            double severity = (std::rand() % 100) / 100.0;
+            double severity = roll(rng);
             todays_.push_back(std::make_unique<InspectionEvent>(severity));
         }
     }
@@ -40,13 +55,21 @@ void EventManager::generateForNewDay(const CarWash &wash) {
 
 void EventManager::applyAll(CarWash &wash) {
     for (auto &e: todays_) {
-        if (e) e->apply(wash);
+        if (!e) continue;
+        e->apply(wash);
+
+        double value = 0.0;
+        JournalRecord r;
+        r.type = JournalType::EventApplied;
+        r.subject = static_cast<std::uint8_t>(eventKind(*e, value));
+        r.value = static_cast<float>(value);
+        wash.journal(r);
     }
 }
 
-void EventManager::startNewDay(CarWash &wash) {
+void EventManager::startNewDay(CarWash &wash, Rng &rng) {
     clear();
-    generateForNewDay(wash);
+    generateForNewDay(wash, rng);
     applyAll(wash);
 }
 
@@ -62,3 +85,27 @@ void EventManager::print(std::ostream &os) const {
         }
     }
 }
+
+void EventManager::save(BinaryWriter &w) const {
+    w.u32(static_cast<std::uint32_t>(todays_.size()));
+    for (const auto &e: todays_) {
+        double value = 0.0;
+        const int kind = eventKind(*e, value);
+        if (kind < 0) throw SaveFileException("Eveniment necunoscut: " + e->name());
+        w.u8(static_cast<std::uint8_t>(kind));
+        w.f64(value);
+    }
+}
+
+void EventManager::load(BinaryReader &r) {
+    todays_.clear();
+    const size_t n = r.count(9);
+    for (size_t i = 0; i < n; ++i) {
+        const std::uint8_t type = r.u8();
+        const double value = r.f64();
+        if (type == 0) todays_.push_back(std::make_unique<WeatherEvent>(value));
+        else if (type == 1) todays_.push_back(std::make_unique<HolidayEvent>());
+        else if (type == 2) todays_.push_back(std::make_unique<InspectionEvent>(value));
+        else throw SaveFileException("Eveniment invalid in salvare");
+    }
+}
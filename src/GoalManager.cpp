@@ -1,36 +1,61 @@
 #include "../headers/GoalManager.h"
 #include "../headers/CarWash.h"
+#include "../headers/BinaryIO.h"
 
 #include <iomanip>
 #include <ostream>
 
-void GoalManager::checkAll(const CarWash &wash) {
-    for (auto &g: goals_) {
-        if (g) g->check(wash);
+GoalManager::GoalManager(const GoalManager &other)
+    : byMetric_(other.byMetric_),
+      lastValue_(other.lastValue_),
+      total_(other.total_),
+      achieved_(other.achieved_) {
+    goals_.reserve(other.goals_.size());
+    for (const auto &g: other.goals_) goals_.push_back(g ? g->clone() : nullptr);
+}
+
+double GoalManager::metricValue(const CarWash &wash, GoalMetric m) {
+    switch (m) {
+        case GoalMetric::Cash: return wash.totalCash();
+        case GoalMetric::CarsServed: return static_cast<double>(wash.totalCarsServed());
+        case GoalMetric::Satisfaction: return wash.averageSatisfaction();
     }
+    return 0.0;
 }
 
-bool GoalManager::allAchieved() const {
-    int total = 0;
-    int done = 0;
-    for (const auto &g: goals_) {
-        if (!g) continue;
-        ++total;
-        if (g->isAchieved()) ++done;
+void GoalManager::add(std::unique_ptr<Goal> g) {
+    if (g) {
+        const auto m = static_cast<size_t>(g->metric());
+        byMetric_[m].push_back(goals_.size());
+        lastValue_[m].reset(); // noul obiectiv n-a fost verificat inca
+        ++total_;
+        if (g->isAchieved()) ++achieved_;
     }
-    return total > 0 && done == total;
+    goals_.push_back(std::move(g));
 }
 
-double GoalManager::completionRatio() const {
-    int total = 0;
-    int done = 0;
+void GoalManager::recount() {
+    total_ = 0;
+    achieved_ = 0;
     for (const auto &g: goals_) {
         if (!g) continue;
-        ++total;
-        if (g->isAchieved()) ++done;
+        ++total_;
+        if (g->isAchieved()) ++achieved_;
+    }
+}
+
+void GoalManager::checkAll(const CarWash &wash) {
+    for (size_t m = 0; m < GOAL_METRICS; ++m) {
+        if (byMetric_[m].empty()) continue;
+        const double value = metricValue(wash, static_cast<GoalMetric>(m));
+        if (lastValue_[m] == value) continue; // marime neschimbata: progresul e acelasi
+        lastValue_[m] = value;
+        for (size_t i: byMetric_[m]) {
+            Goal &g = *goals_[i];
+            const bool before = g.isAchieved();
+            if (g.check(wash) != before) achieved_ += before ? -1 : 1;
+        }
     }
-    if (total == 0) return 0.0;
-    return static_cast<double>(done) / static_cast<double>(total);
 }
 
 void GoalManager::print(std::ostream &os, const CarWash & /*wash*/) const {
@@ -58,3 +83,23 @@ void GoalManager::print(std::ostream &os, const CarWash & /*wash*/) const {
             << std::fixed << std::setprecision(1)
             << global << "%\n";
 }
+
+void GoalManager::save(BinaryWriter &w) const {
+    w.u32(static_cast<std::uint32_t>(goals_.size()));
+    for (const auto &g: goals_) {
+        w.boolean(g && g->isAchieved());
+        w.f64(g ? g->progress() : 0.0);
+    }
+}
+
+void GoalManager::load(BinaryReader &r) {
+    const size_t n = r.count(9);
+    if (n != goals_.size()) throw SaveFileException("Numar de obiective diferit in salvare");
+    for (auto &g: goals_) {
+        const bool achieved = r.boolean();
+        const double progress = r.f64();
+        if (g) g->restore(achieved, progress);
+    }
+    recount();
+    lastValue_.fill(std::nullopt); // progresul salvat se reverifica la urmatorul checkAll
+}
@@ -0,0 +1,48 @@
+#include "../headers/HistoryLog.h"
+#include "../headers/BinaryIO.h"
+#include "../headers/ReportHistory.h"
+
+#include <random>
+
+/**
+ * @file HistoryLog.cpp
+ * @brief Appending report rows to a checkpoint's side file and reading them back.
+ */
+
+HistoryLog::HistoryLog(std::string path)
+    : path_(std::move(path)),
+      out_(path_, std::ios::binary | std::ios::trunc) {
+    if (!out_) throw SaveFileException("Nu pot scrie fisierul: " + path_);
+    std::random_device rd;
+    id_ = (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+
+    BinaryWriter w;
+    w.u32(MAGIC);
+    w.u64(id_);
+    out_.write(w.data().data(), static_cast<std::streamsize>(w.data().size()));
+    out_.flush();
+    if (!out_) throw SaveFileException("Scriere esuata: " + path_);
+    bytes_ = w.data().size();
+}
+
+void HistoryLog::append(const ReportHistory &history) {
+    if (history.size() <= rows_) return;
+    BinaryWriter w;
+    history.saveRows(w, static_cast<size_t>(rows_));
+    out_.write(w.data().data(), static_cast<std::streamsize>(w.data().size()));
+    out_.flush();
+    if (!out_) throw SaveFileException("Scriere esuata: " + path_);
+    rows_ = history.size();
+    bytes_ += w.data().size();
+}
+
+void HistoryLog::read(const std::string &path, std::uint64_t id, std::uint64_t rows, std::uint64_t bytes,
+                      ReportHistory &history) {
+    BinaryReader r = BinaryReader::fromFile(path);
+    if (r.size() < bytes) throw SaveFileException("Istoric trunchiat: " + path);
+    if (r.u32() != MAGIC || r.u64() != id) {
+        throw SaveFileException("Istoricul " + path + " nu apartine acestei salvari");
+    }
+    for (std::uint64_t d = 0; d < rows; ++d) history.loadRow(r);
+    if (r.position() != bytes) throw SaveFileException("Istoric de rapoarte invalid: " + path);
+}
@@ -1,4 +1,5 @@
 #include "../headers/Inventory.h"
+#include "../headers/BinaryIO.h"
 #include <ostream>
 
 bool Inventory::takeIfCan(const WashService &sp, int cars) {
@@ -18,6 +19,18 @@ bool Inventory::takeIfCan(const WashService &sp, int cars) {
     return true;
 }
 
+void Inventory::save(BinaryWriter &w) const {
+    w.i32(water_);
+    w.i32(shampoo_);
+    w.i32(wax_);
+}
+
+void Inventory::load(BinaryReader &r) {
+    water_ = r.i32();
+    shampoo_ = r.i32();
+    wax_ = r.i32();
+}
+
 std::ostream &operator<<(std::ostream &os, const Inventory &inv) {
     os << "Inventory{water=" << inv.water()
             << ", shampoo=" << inv.shampoo()
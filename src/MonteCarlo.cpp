@@ -0,0 +1,132 @@
+#include "../headers/MonteCarlo.h"
+#include "../headers/CarWash.h"
+#include "../headers/Reductions.h"
+#include "../headers/Rng.h"
+#include "../headers/Scenario.h"
+#include "../headers/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+
+/**
+ * @file MonteCarlo.cpp
+ * @brief Parallel replica runner and the reduction of replica results into bands.
+ */
+
+namespace {
+    /**
+     * @brief Percentile with linear interpolation between closest ranks.
+     *
+     * @param sorted Values sorted ascending (non-empty).
+     * @param q Quantile in [0, 1].
+     */
+    double percentile(const std::vector<double> &sorted, double q) {
+        const double pos = q * static_cast<double>(sorted.size() - 1);
+        const auto lo = static_cast<size_t>(std::floor(pos));
+        const size_t hi = std::min(lo + 1, sorted.size() - 1);
+        const double frac = pos - static_cast<double>(lo);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+    }
+
+    /**
+     * @brief Builds the band of one metric; values are in replica order.
+     *
+     * Two-pass mean / variance with the Reductions kernels: a compensated sum for the mean,
+     * then the sum of squared deviations from it, both split into blocks on the pool.
+     */
+    MetricBand band(std::vector<double> values, ThreadPool *pool) {
+        MetricBand b;
+        if (values.empty()) return b;
+
+        const auto n = static_cast<double>(values.size());
+        b.mean = Reductions::kahanSum(values, pool) / n;
+        b.variance = values.size() > 1 ? Reductions::sumSquaredDeviations(values, b.mean, pool) / (n - 1.0) : 0.0;
+
+        std::sort(values.begin(), values.end());
+        b.min = values.front();
+        b.max = values.back();
+        b.p10 = percentile(values, 0.10);
+        b.p50 = percentile(values, 0.50);
+        b.p90 = percentile(values, 0.90);
+        return b;
+    }
+
+    void printBand(std::ostream &os, const char *label, const MetricBand &b, int precision) {
+        os << "  " << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(precision)
+                << " mean=" << b.mean
+                << " sd=" << std::sqrt(b.variance)
+                << " p10=" << b.p10
+                << " p50=" << b.p50
+                << " p90=" << b.p90
+                << " [" << b.min << ", " << b.max << "]\n";
+    }
+} // namespace
+
+MonteCarloRunner::MonteCarloRunner(const Scenario &scenario, int days, std::uint64_t baseSeed)
+    : scenario_(scenario), days_(days), baseSeed_(baseSeed) {
+}
+
+std::uint64_t MonteCarloRunner::seedFor(std::uint64_t baseSeed, int replica) noexcept {
+    return deriveSeed(baseSeed, static_cast<std::uint64_t>(replica));
+}
+
+std::vector<ReplicaResult> MonteCarloRunner::run(int replicas, int threads) const {
+    ThreadPool pool(threads);
+    return run(replicas, pool);
+}
+
+std::vector<ReplicaResult> MonteCarloRunner::run(int replicas, ThreadPool &pool) const {
+    std::vector<ReplicaResult> results(static_cast<size_t>(replicas > 0 ? replicas : 0));
+
+    pool.parallelFor(replicas, [&](int i) {
+        const std::uint64_t seed = seedFor(baseSeed_, i);
+        auto game = scenario_.build(nullptr);
+        game->seed(seed);
+        game->runDays(days_);
+
+        const Statistics stats = game->statistics();
+        ReplicaResult &r = results[static_cast<size_t>(i)];
+        r.seed = seed;
+        r.cars = stats.totalCars();
+        r.revenue = stats.totalRevenue();
+        r.lost = stats.totalLost();
+        r.satisfaction = stats.avgSatisfactionWeighted();
+        r.finalCash = game->totalCash();
+    });
+    return results;
+}
+
+MonteCarloSummary MonteCarloRunner::summarize(const std::vector<ReplicaResult> &results, int days,
+                                              ThreadPool *pool) {
+    MonteCarloSummary s;
+    s.replicas = static_cast<int>(results.size());
+    s.days = days;
+
+    std::vector<double> revenue, lost, sat, cash;
+    revenue.reserve(results.size());
+    lost.reserve(results.size());
+    sat.reserve(results.size());
+    cash.reserve(results.size());
+    for (const auto &r: results) {
+        revenue.push_back(r.revenue);
+        lost.push_back(static_cast<double>(r.lost));
+        sat.push_back(r.satisfaction);
+        cash.push_back(r.finalCash);
+    }
+    s.revenue = band(std::move(revenue), pool);
+    s.lost = band(std::move(lost), pool);
+    s.satisfaction = band(std::move(sat), pool);
+    s.finalCash = band(std::move(cash), pool);
+    return s;
+}
+
+void MonteCarloRunner::print(std::ostream &os, const MonteCarloSummary &s) {
+    os << "=== MONTE CARLO ===\n";
+    os << "Replicas: " << s.replicas << " | Days/replica: " << s.days << "\n";
+    printBand(os, "Revenue", s.revenue, 2);
+    printBand(os, "Lost", s.lost, 2);
+    printBand(os, "Satisfaction", s.satisfaction, 3);
+    printBand(os, "Final cash", s.finalCash, 2);
+}
@@ -0,0 +1,449 @@
+#include "../headers/Reductions.h"
+#include "../headers/Rng.h"
+#include "../headers/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CARWASH_AVX2_KERNELS 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @file Reductions.cpp
+ * @brief Scalar and AVX2 reduction kernels, runtime dispatch and block-parallel drivers.
+ */
+
+namespace {
+    /**
+     * @brief Kernels of one instruction set; each reduces one contiguous block.
+     */
+    struct Kernels {
+        SimdLevel level;
+        double (*sum)(const double *, size_t);
+        std::int64_t (*sumInt)(const std::int32_t *, size_t);
+        double (*kahan)(const double *, size_t);
+        double (*sqDev)(const double *, size_t, double);
+        void (*weighted)(const double *, const std::int32_t *, size_t, double &, double &);
+        void (*minMax)(const double *, size_t, double &, double &);
+        void (*minMaxInt)(const std::int32_t *, size_t, std::int32_t &, std::int32_t &);
+    };
+
+    /**
+     * @brief Compensated accumulator (Kahan-Babuska style correction term kept separately).
+     */
+    struct Kahan {
+        double s{0.0};
+        double c{0.0};
+
+        void add(double x) noexcept {
+            const double y = x - c;
+            const double t = s + y;
+            c = (t - s) - y;
+            s = t;
+        }
+    };
+
+    // --- scalar reference kernels -------------------------------------------------
+
+    double sumScalar(const double *p, size_t n) {
+        double s = 0.0;
+        for (size_t i = 0; i < n; ++i) s += p[i];
+        return s;
+    }
+
+    std::int64_t sumIntScalar(const std::int32_t *p, size_t n) {
+        std::int64_t s = 0;
+        for (size_t i = 0; i < n; ++i) s += p[i];
+        return s;
+    }
+
+    double kahanScalar(const double *p, size_t n) {
+        Kahan k;
+        for (size_t i = 0; i < n; ++i) k.add(p[i]);
+        return k.s;
+    }
+
+    double sqDevScalar(const double *p, size_t n, double center) {
+        double s = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double d = p[i] - center;
+            s += d * d;
+        }
+        return s;
+    }
+
+    void weightedScalar(const double *v, const std::int32_t *w, size_t n, double &num, double &den) {
+        num = 0.0;
+        den = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double wi = w[i];
+            num += v[i] * wi;
+            den += wi;
+        }
+    }
+
+    template<typename T>
+    void minMaxScalar(const T *p, size_t n, T &mn, T &mx) {
+        mn = p[0];
+        mx = p[0];
+        for (size_t i = 1; i < n; ++i) {
+            mn = std::min(mn, p[i]);
+            mx = std::max(mx, p[i]);
+        }
+    }
+
+    constexpr Kernels kScalar{
+        SimdLevel::Scalar, sumScalar, sumIntScalar, kahanScalar, sqDevScalar, weightedScalar,
+        minMaxScalar<double>, minMaxScalar<std::int32_t>
+    };
+
+#ifdef CARWASH_AVX2_KERNELS
+    // --- AVX2 kernels (4 doubles / 8 ints per register) ----------------------------
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+    AVX2_TARGET double lanesSum(__m256d v) {
+        alignas(32) double l[4];
+        _mm256_store_pd(l, v);
+        return (l[0] + l[1]) + (l[2] + l[3]);
+    }
+
+    AVX2_TARGET double sumAvx2(const double *p, size_t n) {
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+            a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+            a2 = _mm256_add_pd(a2, _mm256_loadu_pd(p + i + 8));
+            a3 = _mm256_add_pd(a3, _mm256_loadu_pd(p + i + 12));
+        }
+        for (; i + 4 <= n; i += 4) a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+        double s = lanesSum(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+        for (; i < n; ++i) s += p[i];
+        return s;
+    }
+
+    AVX2_TARGET std::int64_t sumIntAvx2(const std::int32_t *p, size_t n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        alignas(32) std::int64_t l[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(l), acc);
+        std::int64_t s = l[0] + l[1] + l[2] + l[3];
+        for (; i < n; ++i) s += p[i];
+        return s;
+    }
+
+    AVX2_TARGET double kahanAvx2(const double *p, size_t n) {
+        __m256d s = _mm256_setzero_pd();
+        __m256d c = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d y = _mm256_sub_pd(_mm256_loadu_pd(p + i), c);
+            const __m256d t = _mm256_add_pd(s, y);
+            c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+            s = t;
+        }
+        alignas(32) double ls[4], lc[4];
+        _mm256_store_pd(ls, s);
+        _mm256_store_pd(lc, c);
+        Kahan k;
+        for (int l = 0; l < 4; ++l) {
+            k.add(ls[l]);
+            k.add(-lc[l]);
+        }
+        for (; i < n; ++i) k.add(p[i]);
+        return k.s;
+    }
+
+    AVX2_TARGET double sqDevAvx2(const double *p, size_t n, double center) {
+        const __m256d m = _mm256_set1_pd(center);
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(p + i), m);
+            const __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(p + i + 4), m);
+            a0 = _mm256_add_pd(a0, _mm256_mul_pd(d0, d0));
+            a1 = _mm256_add_pd(a1, _mm256_mul_pd(d1, d1));
+        }
+        double s = lanesSum(_mm256_add_pd(a0, a1));
+        for (; i < n; ++i) {
+            const double d = p[i] - center;
+            s += d * d;
+        }
+        return s;
+    }
+
+    AVX2_TARGET void weightedAvx2(const double *v, const std::int32_t *w, size_t n, double &num, double &den) {
+        __m256d an = _mm256_setzero_pd();
+        __m256d ad = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d wi = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i)));
+            an = _mm256_add_pd(an, _mm256_mul_pd(_mm256_loadu_pd(v + i), wi));
+            ad = _mm256_add_pd(ad, wi);
+        }
+        num = lanesSum(an);
+        den = lanesSum(ad);
+        for (; i < n; ++i) {
+            const double wi = w[i];
+            num += v[i] * wi;
+            den += wi;
+        }
+    }
+
+    AVX2_TARGET void minMaxAvx2(const double *p, size_t n, double &mn, double &mx) {
+        __m256d vmin = _mm256_set1_pd(p[0]);
+        __m256d vmax = vmin;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d x = _mm256_loadu_pd(p + i);
+            vmin = _mm256_min_pd(vmin, x);
+            vmax = _mm256_max_pd(vmax, x);
+        }
+        alignas(32) double lmin[4], lmax[4];
+        _mm256_store_pd(lmin, vmin);
+        _mm256_store_pd(lmax, vmax);
+        mn = std::min({lmin[0], lmin[1], lmin[2], lmin[3]});
+        mx = std::max({lmax[0], lmax[1], lmax[2], lmax[3]});
+        for (; i < n; ++i) {
+            mn = std::min(mn, p[i]);
+            mx = std::max(mx, p[i]);
+        }
+    }
+
+    AVX2_TARGET void minMaxIntAvx2(const std::int32_t *p, size_t n, std::int32_t &mn, std::int32_t &mx) {
+        __m256i vmin = _mm256_set1_epi32(p[0]);
+        __m256i vmax = vmin;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            vmin = _mm256_min_epi32(vmin, x);
+            vmax = _mm256_max_epi32(vmax, x);
+        }
+        alignas(32) std::int32_t lmin[8], lmax[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lmin), vmin);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lmax), vmax);
+        mn = *std::min_element(lmin, lmin + 8);
+        mx = *std::max_element(lmax, lmax + 8);
+        for (; i < n; ++i) {
+            mn = std::min(mn, p[i]);
+            mx = std::max(mx, p[i]);
+        }
+    }
+
+#undef AVX2_TARGET
+
+    constexpr Kernels kAvx2{
+        SimdLevel::Avx2, sumAvx2, sumIntAvx2, kahanAvx2, sqDevAvx2, weightedAvx2, minMaxAvx2, minMaxIntAvx2
+    };
+#endif
+
+    const Kernels &kernelsFor(SimdLevel level) noexcept {
+#ifdef CARWASH_AVX2_KERNELS
+        if (level == SimdLevel::Avx2) return kAvx2;
+#endif
+        (void) level;
+        return kScalar;
+    }
+
+    std::atomic<const Kernels *> g_active{nullptr};
+
+    const Kernels &active() noexcept {
+        const Kernels *k = g_active.load(std::memory_order_acquire);
+        if (!k) {
+            Reductions::setLevel(Reductions::supportedLevel());
+            k = g_active.load(std::memory_order_acquire);
+        }
+        return *k;
+    }
+
+    /**
+     * @brief Reduces [0, n) in blocks of PARALLEL_BLOCK, on the pool if there is one.
+     *
+     * The blocks depend on n only, so the partials (and their in-order combination) are the
+     * same with or without a pool and for any thread count.
+     */
+    template<typename Partial, typename BlockFn>
+    std::vector<Partial> blocks(size_t n, ThreadPool *pool, BlockFn fn) {
+        constexpr size_t B = Reductions::PARALLEL_BLOCK;
+        if (n <= B) return {fn(size_t{0}, n)};
+        std::vector<Partial> parts((n + B - 1) / B);
+        const auto reduce = [&](int b) {
+            const size_t lo = static_cast<size_t>(b) * B;
+            parts[static_cast<size_t>(b)] = fn(lo, std::min(n, lo + B));
+        };
+        if (pool) {
+            pool->parallelFor(static_cast<int>(parts.size()), reduce);
+        } else {
+            for (int b = 0; b < static_cast<int>(parts.size()); ++b) reduce(b);
+        }
+        return parts;
+    }
+
+    template<typename T, typename MinMax>
+    ColumnExtremes<T> extremesOf(std::span<const T> v, ThreadPool *pool, MinMax minMax) {
+        if (v.empty()) return {};
+        const auto parts = blocks<ColumnExtremes<T> >(v.size(), pool, [&](size_t lo, size_t hi) {
+            ColumnExtremes<T> e;
+            minMax(v.data() + lo, hi - lo, e.min, e.max);
+            // the kernels only find the values; the first position is a short scan
+            e.argMin = static_cast<size_t>(std::find(v.begin() + lo, v.begin() + hi, e.min) - v.begin());
+            e.argMax = static_cast<size_t>(std::find(v.begin() + lo, v.begin() + hi, e.max) - v.begin());
+            return e;
+        });
+        ColumnExtremes<T> e = parts.front();
+        for (size_t b = 1; b < parts.size(); ++b) {
+            if (parts[b].min < e.min) {
+                e.min = parts[b].min;
+                e.argMin = parts[b].argMin;
+            }
+            if (parts[b].max > e.max) {
+                e.max = parts[b].max;
+                e.argMax = parts[b].argMax;
+            }
+        }
+        return e;
+    }
+
+    bool close(double a, double b, double scale) noexcept {
+        return std::fabs(a - b) <= 1e-12 * scale + 1e-300;
+    }
+} // namespace
+
+SimdLevel Reductions::supportedLevel() noexcept {
+#ifdef CARWASH_AVX2_KERNELS
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel Reductions::level() noexcept {
+    return active().level;
+}
+
+void Reductions::setLevel(SimdLevel level) noexcept {
+    if (level != SimdLevel::Scalar && (level > supportedLevel() || !selfCheck(level))) level = SimdLevel::Scalar;
+    g_active.store(&kernelsFor(level), std::memory_order_release);
+}
+
+const char *Reductions::levelName(SimdLevel level) noexcept {
+    return level == SimdLevel::Avx2 ? "avx2" : "scalar";
+}
+
+bool Reductions::selfCheck(SimdLevel level) noexcept {
+    if (level > supportedLevel()) return false;
+    const Kernels &k = kernelsFor(level);
+
+    Rng rng(0x5EED);
+    std::vector<double> v(1031);
+    std::vector<std::int32_t> w(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = rng.uniformInt(-1000000, 1000000) / 1000.0;
+        w[i] = rng.uniformInt(-2000000, 2000000);
+    }
+    std::vector<std::int32_t> weights(w.size());
+    for (size_t i = 0; i < w.size(); ++i) weights[i] = std::abs(w[i]) % 50;
+
+    // lengths around the vector widths exercise every loop tail
+    for (size_t n: {size_t{1}, size_t{3}, size_t{4}, size_t{5}, size_t{8}, size_t{17}, size_t{33}, v.size()}) {
+        double scale = 0.0;
+        for (size_t i = 0; i < n; ++i) scale += std::fabs(v[i]) * (1.0 + weights[i]);
+
+        if (!close(k.sum(v.data(), n), kScalar.sum(v.data(), n), scale)) return false;
+        if (!close(k.kahan(v.data(), n), kScalar.kahan(v.data(), n), scale)) return false;
+        if (!close(k.sqDev(v.data(), n, 1.5), kScalar.sqDev(v.data(), n, 1.5), scale * scale + 1.0)) return false;
+        if (k.sumInt(w.data(), n) != kScalar.sumInt(w.data(), n)) return false;
+
+        double n1, d1, n2, d2;
+        k.weighted(v.data(), weights.data(), n, n1, d1);
+        kScalar.weighted(v.data(), weights.data(), n, n2, d2);
+        if (!close(n1, n2, scale) || d1 != d2) return false;
+
+        double mn1, mx1, mn2, mx2;
+        k.minMax(v.data(), n, mn1, mx1);
+        kScalar.minMax(v.data(), n, mn2, mx2);
+        if (mn1 != mn2 || mx1 != mx2) return false;
+
+        std::int32_t imn1, imx1, imn2, imx2;
+        k.minMaxInt(w.data(), n, imn1, imx1);
+        kScalar.minMaxInt(w.data(), n, imn2, imx2);
+        if (imn1 != imn2 || imx1 != imx2) return false;
+    }
+    return true;
+}
+
+double Reductions::sum(std::span<const double> v, ThreadPool *pool) {
+    const Kernels &k = active();
+    double s = 0.0;
+    for (double part: blocks<double>(v.size(), pool, [&](size_t lo, size_t hi) { return k.sum(v.data() + lo, hi - lo); })) {
+        s += part;
+    }
+    return s;
+}
+
+std::int64_t Reductions::sum(std::span<const std::int32_t> v, ThreadPool *pool) {
+    const Kernels &k = active();
+    std::int64_t s = 0;
+    for (std::int64_t part: blocks<std::int64_t>(v.size(), pool,
+                                                  [&](size_t lo, size_t hi) { return k.sumInt(v.data() + lo, hi - lo); })) {
+        s += part;
+    }
+    return s;
+}
+
+double Reductions::kahanSum(std::span<const double> v, ThreadPool *pool) {
+    const Kernels &k = active();
+    Kahan acc;
+    for (double part: blocks<double>(v.size(), pool, [&](size_t lo, size_t hi) { return k.kahan(v.data() + lo, hi - lo); })) {
+        acc.add(part);
+    }
+    return acc.s;
+}
+
+double Reductions::sumSquaredDeviations(std::span<const double> v, double center, ThreadPool *pool) {
+    const Kernels &k = active();
+    double s = 0.0;
+    for (double part: blocks<double>(v.size(), pool,
+                                     [&](size_t lo, size_t hi) { return k.sqDev(v.data() + lo, hi - lo, center); })) {
+        s += part;
+    }
+    return s;
+}
+
+double Reductions::weightedMean(std::span<const double> v, std::span<const std::int32_t> w, ThreadPool *pool) {
+    const Kernels &k = active();
+    struct Part {
+        double num{0.0};
+        double den{0.0};
+    };
+    const size_t n = std::min(v.size(), w.size());
+    double num = 0.0;
+    double den = 0.0;
+    for (const Part &p: blocks<Part>(n, pool, [&](size_t lo, size_t hi) {
+        Part part;
+        k.weighted(v.data() + lo, w.data() + lo, hi - lo, part.num, part.den);
+        return part;
+    })) {
+        num += p.num;
+        den += p.den;
+    }
+    return den == 0.0 ? 0.0 : num / den;
+}
+
+ColumnExtremes<double> Reductions::extremes(std::span<const double> v, ThreadPool *pool) {
+    return extremesOf(v, pool, active().minMax);
+}
+
+ColumnExtremes<std::int32_t> Reductions::extremes(std::span<const std::int32_t> v, ThreadPool *pool) {
+    return extremesOf(v, pool, active().minMaxInt);
+}
@@ -0,0 +1,120 @@
+#include "../headers/ReplayLog.h"
+#include "../headers/CarWash.h"
+
+/**
+ * @file ReplayLog.cpp
+ * @brief Recording and deterministic re-execution of interactive command logs.
+ */
+
+ReplayRecorder::ReplayRecorder(std::string path, std::uint64_t seed, const CarWash &initial)
+    : path_(std::move(path)),
+      out_(path_, std::ios::binary | std::ios::trunc) {
+    if (!out_) throw SaveFileException("Nu pot scrie fisierul: " + path_);
+    BinaryWriter snapshot;
+    initial.saveState(snapshot);
+
+    BinaryWriter w;
+    w.u32(ReplayLog::MAGIC);
+    w.u32(ReplayLog::VERSION);
+    w.u64(seed);
+    w.str(snapshot.data());
+    append(w);
+}
+
+void ReplayRecorder::append(const BinaryWriter &w) {
+    out_.write(w.data().data(), static_cast<std::streamsize>(w.data().size()));
+    out_.flush();
+    if (!out_) throw SaveFileException("Scriere esuata: " + path_);
+}
+
+void ReplayRecorder::record(int day, int minute, const std::string &command) {
+    if (finished_) return;
+    BinaryWriter w;
+    w.u8(ReplayLog::TAG_COMMAND);
+    w.i32(day);
+    w.pod(static_cast<std::uint16_t>(minute));
+    w.str(command);
+    append(w);
+}
+
+void ReplayRecorder::loaded(const CarWash &state) {
+    if (finished_) return;
+    BinaryWriter snapshot;
+    state.saveState(snapshot);
+    BinaryWriter w;
+    w.u8(ReplayLog::TAG_LOADED);
+    w.str(snapshot.data());
+    append(w);
+}
+
+void ReplayRecorder::finish(const CarWash &final) {
+    if (finished_) return;
+    finished_ = true;
+    BinaryWriter w;
+    w.u8(ReplayLog::TAG_END);
+    w.u64(final.stateDigest());
+    append(w);
+}
+
+BinaryReader ReplaySandbox::open(const std::string &path) const {
+    if (!loaded_) throw SaveFileException("Nu pot deschide fisierul: " + path);
+    return BinaryReader(*loaded_);
+}
+
+ReplayLog ReplayLog::read(const std::string &path) {
+    BinaryReader r = BinaryReader::fromFile(path);
+    if (r.u32() != MAGIC) throw SaveFileException("Fisierul nu este un log de replay: " + path);
+    const std::uint32_t version = r.u32();
+    if (version != VERSION) throw SaveFileException("Versiune de log nesuportata: " + std::to_string(version));
+
+    ReplayLog log;
+    log.seed = r.u64();
+    log.snapshot = r.str();
+    while (!r.atEnd()) {
+        const std::uint8_t tag = r.u8();
+        if (tag == TAG_END) {
+            log.finalDigest = r.u64();
+            log.complete = true;
+            break;
+        }
+        if (tag == TAG_LOADED) {
+            if (log.entries.empty()) throw SaveFileException("Inregistrare invalida in log");
+            log.entries.back().loaded = r.str();
+            continue;
+        }
+        if (tag != TAG_COMMAND) throw SaveFileException("Inregistrare invalida in log");
+        ReplayEntry e;
+        e.day = r.i32();
+        e.minute = r.pod<std::uint16_t>();
+        e.command = r.str();
+        log.entries.push_back(std::move(e));
+    }
+    return log;
+}
+
+ReplayResult ReplayLog::replay() const {
+    BinaryReader r(snapshot);
+    ReplayResult result;
+    result.state = CarWash::restoreState(r);
+    CarWash &game = *result.state;
+    ReplaySandbox sandbox;
+    game.setSandbox(&sandbox);
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const ReplayEntry &e = entries[i];
+        if (result.firstDesync < 0 && (game.currentDay() != e.day || game.currentMinute() != e.minute)) {
+            result.firstDesync = static_cast<int>(i);
+        }
+        ++result.executed;
+        sandbox.expect(e.loaded ? &*e.loaded : nullptr);
+        try {
+            if (!game.executeCommand(e.command)) break;
+        } catch (const CarWashException &) {
+            // the session printed the error and went on; so does the replay
+        }
+    }
+    game.setSandbox(nullptr);
+    result.digest = game.stateDigest();
+    result.verified = complete && result.digest == finalDigest;
+    return result;
+}
@@ -0,0 +1,288 @@
+#include "../headers/ReportExporter.h"
+#include "../headers/CarWashExceptions.h"
+#include "../headers/DailyReport.h"
+#include "../headers/EventJournal.h"
+
+#include <charconv>
+#include <type_traits>
+
+/**
+ * @file ReportExporter.cpp
+ * @brief Column chunks, their CSV / binary encodings and the background writer thread.
+ */
+
+namespace {
+    template<typename T>
+    void put(std::string &out, const T &v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.append(reinterpret_cast<const char *>(&v), sizeof(T));
+    }
+
+    void putStr(std::string &out, const std::string &s) {
+        put(out, static_cast<std::uint32_t>(s.size()));
+        out += s;
+    }
+
+    /**
+     * @brief Appends a number in its shortest round-trip form.
+     */
+    template<typename T>
+    void putText(std::string &out, T v) {
+        char buf[32];
+        const auto res = std::to_chars(buf, buf + sizeof(buf), v);
+        out.append(buf, res.ptr);
+    }
+
+    void putCsvField(std::string &out, const std::string &s) {
+        if (s.find_first_of(",\"\n") == std::string::npos) {
+            out += s;
+            return;
+        }
+        out += '"';
+        for (char c: s) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+
+    void putCsvValue(std::string &out, const ColumnChunk::Data &data, size_t row) {
+        std::visit([&](const auto &v) {
+            using T = typename std::decay_t<decltype(v)>::value_type;
+            if constexpr (std::is_same_v<T, std::string>) putCsvField(out, v[row]);
+            else if constexpr (std::is_same_v<T, std::uint8_t>) putText(out, static_cast<unsigned>(v[row]));
+            else putText(out, v[row]);
+        }, data);
+    }
+
+    const char *extension(ExportFormat format) {
+        return format == ExportFormat::Csv ? ".csv" : ".cwc";
+    }
+} // namespace
+
+ColumnChunk ColumnChunk::like(const ColumnChunk &schema) {
+    ColumnChunk c;
+    for (const Column &col: schema.columns_) {
+        c.columns_.push_back({col.name, std::visit([](const auto &v) { return Data{std::decay_t<decltype(v)>{}}; }, col.data)});
+    }
+    return c;
+}
+
+void ColumnChunk::reserve(size_t rows) {
+    for (Column &col: columns_) std::visit([rows](auto &v) { v.reserve(rows); }, col.data);
+}
+
+ReportExporter::ReportExporter(const std::string &prefix, ExportFormat format, bool customers, size_t chunkRows)
+    : format_(format), customers_(customers), chunkRows_(chunkRows > 0 ? chunkRows : 1) {
+    ColumnChunk &days = chunks_[Days];
+    days.addColumn<std::int32_t>("day");
+    days.addColumn<std::int32_t>("cars");
+    days.addColumn<std::int32_t>("lost");
+    days.addColumn<double>("revenue");
+    days.addColumn<double>("satisfaction");
+
+    ColumnChunk &services = chunks_[Services];
+    services.addColumn<std::int32_t>("day");
+    services.addColumn<std::string>("service");
+    services.addColumn<std::int32_t>("cars");
+    services.addColumn<double>("revenue");
+
+    ColumnChunk &outcomes = chunks_[Customers];
+    outcomes.addColumn<std::int32_t>("day");
+    outcomes.addColumn<std::int32_t>("minute");
+    outcomes.addColumn<std::uint32_t>("customer_id");
+    outcomes.addColumn<std::uint8_t>("customer_type");
+    outcomes.addColumn<std::uint8_t>("served");
+    outcomes.addColumn<std::uint8_t>("loss_reason");
+    outcomes.addColumn<std::int32_t>("wait_min");
+    outcomes.addColumn<float>("satisfaction");
+    outcomes.addColumn<std::uint8_t>("service_kind");
+    outcomes.addColumn<double>("price");
+
+    const char *names[TABLES] = {"_days", "_services", "_customers"};
+    for (size_t t = 0; t < TABLES; ++t) {
+        if (t == Customers && !customers_) continue;
+        const std::string path = prefix + names[t] + extension(format_);
+        files_[t].open(path, std::ios::binary | std::ios::trunc);
+        if (!files_[t]) throw ExportException("Nu se poate crea fisierul de export: " + path);
+        std::string header;
+        encodeHeader(header, chunks_[t]);
+        files_[t].write(header.data(), static_cast<std::streamsize>(header.size()));
+        chunks_[t].reserve(chunkRows_);
+    }
+
+    writer_ = std::thread([this] { writerLoop(); });
+}
+
+ReportExporter::~ReportExporter() {
+    try {
+        finish();
+    } catch (...) {
+        // a destructor cannot report the error; callers that care call finish() themselves
+    }
+}
+
+void ReportExporter::addDay(const DailyReport &rep) {
+    ColumnChunk &d = chunks_[Days];
+    d.col<std::int32_t>(0).push_back(rep.day());
+    d.col<std::int32_t>(1).push_back(rep.totalCars());
+    d.col<std::int32_t>(2).push_back(rep.lostCustomers());
+    d.col<double>(3).push_back(rep.totalRevenue());
+    d.col<double>(4).push_back(rep.avgSatisfaction());
+    d.endRow();
+    ++days_;
+    if (d.rows() >= chunkRows_) submit(Days);
+
+    ColumnChunk &s = chunks_[Services];
+    const auto &stats = rep.perService();
+    for (size_t k = 0; k < stats.size(); ++k) {
+        if (stats[k].cars == 0) continue;
+        s.col<std::int32_t>(0).push_back(rep.day());
+        s.col<std::string>(1).push_back(rep.keys().name(static_cast<ServiceKey>(k)));
+        s.col<std::int32_t>(2).push_back(stats[k].cars);
+        s.col<double>(3).push_back(stats[k].revenue);
+        s.endRow();
+        if (s.rows() >= chunkRows_) submit(Services);
+    }
+}
+
+void ReportExporter::addOutcome(const JournalRecord &r) {
+    if (!customers_ || (r.type != JournalType::Served && r.type != JournalType::Lost)) return;
+    const bool served = r.type == JournalType::Served;
+    ColumnChunk &c = chunks_[Customers];
+    c.col<std::int32_t>(0).push_back(static_cast<std::int32_t>(r.day));
+    c.col<std::int32_t>(1).push_back(r.minute);
+    c.col<std::uint32_t>(2).push_back(r.ref);
+    c.col<std::uint8_t>(3).push_back(r.subject);
+    c.col<std::uint8_t>(4).push_back(served ? 1 : 0);
+    c.col<std::uint8_t>(5).push_back(served ? 0 : static_cast<std::uint8_t>(r.extra));
+    c.col<std::int32_t>(6).push_back(served ? static_cast<std::int32_t>(r.extra) : 0);
+    c.col<float>(7).push_back(r.value);
+    c.col<std::uint8_t>(8).push_back(served ? static_cast<std::uint8_t>(r.aux) : 0);
+    c.col<double>(9).push_back(r.amount);
+    c.endRow();
+    ++customerRows_;
+    if (c.rows() >= chunkRows_) submit(Customers);
+}
+
+/**
+ * @brief Hands the current chunk of a table to the writer and starts a new one.
+ *
+ * Blocks while MAX_PENDING chunks are already waiting.
+ */
+void ReportExporter::submit(size_t table) {
+    Job job{table, ColumnChunk::like(chunks_[table])};
+    job.chunk.reserve(chunkRows_);
+    std::swap(job.chunk, chunks_[table]);
+    {
+        std::unique_lock lock(m_);
+        space_.wait(lock, [this] { return pending_.size() < MAX_PENDING; });
+        pending_.push_back(std::move(job));
+    }
+    ready_.notify_one();
+}
+
+void ReportExporter::writerLoop() {
+    std::string buf;
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(m_);
+            ready_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+            if (pending_.empty()) return;
+            job = std::move(pending_.front());
+            pending_.pop_front();
+        }
+        space_.notify_one();
+
+        bool ok;
+        try {
+            buf.clear();
+            encode(buf, job.chunk);
+            std::ofstream &f = files_[job.table];
+            f.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+            ok = static_cast<bool>(f);
+        } catch (const std::exception &) {
+            ok = false;
+        }
+        if (!ok) {
+            std::lock_guard lock(m_);
+            if (error_.empty()) error_ = "Eroare la scrierea exportului";
+        }
+    }
+}
+
+void ReportExporter::encodeHeader(std::string &out, const ColumnChunk &schema) const {
+    const auto &cols = schema.columns();
+    if (format_ == ExportFormat::Csv) {
+        for (size_t i = 0; i < cols.size(); ++i) {
+            if (i) out += ',';
+            out += cols[i].name;
+        }
+        out += '\n';
+        return;
+    }
+    put(out, MAGIC);
+    put(out, VERSION);
+    put(out, static_cast<std::uint16_t>(cols.size()));
+    for (const auto &c: cols) {
+        put(out, static_cast<std::uint8_t>(c.data.index()));
+        putStr(out, c.name);
+    }
+}
+
+void ReportExporter::encode(std::string &out, const ColumnChunk &chunk) const {
+    const auto &cols = chunk.columns();
+    if (format_ == ExportFormat::Csv) {
+        for (size_t row = 0; row < chunk.rows(); ++row) {
+            for (size_t i = 0; i < cols.size(); ++i) {
+                if (i) out += ',';
+                putCsvValue(out, cols[i].data, row);
+            }
+            out += '\n';
+        }
+        return;
+    }
+    put(out, static_cast<std::uint32_t>(chunk.rows()));
+    for (const auto &c: cols) {
+        std::visit([&](const auto &v) {
+            using T = typename std::decay_t<decltype(v)>::value_type;
+            if constexpr (std::is_same_v<T, std::string>) {
+                for (const auto &s: v) putStr(out, s);
+            } else {
+                out.append(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(T));
+            }
+        }, c.data);
+    }
+}
+
+void ReportExporter::stopWriter() {
+    if (!writer_.joinable()) return;
+    {
+        std::lock_guard lock(m_);
+        stop_ = true;
+    }
+    ready_.notify_one();
+    writer_.join();
+}
+
+void ReportExporter::finish() {
+    if (finished_) return;
+    finished_ = true;
+    for (size_t t = 0; t < TABLES; ++t) {
+        if (files_[t].is_open() && !chunks_[t].empty()) submit(t);
+    }
+    stopWriter();
+
+    for (auto &f: files_) {
+        if (!f.is_open()) continue;
+        if (format_ == ExportFormat::Binary) {
+            std::string end;
+            put(end, std::uint32_t{0}); // empty chunk: end of file
+            f.write(end.data(), static_cast<std::streamsize>(end.size()));
+        }
+        f.close();
+        if (!f && error_.empty()) error_ = "Eroare la inchiderea exportului";
+    }
+    if (!error_.empty()) throw ExportException(error_);
+}
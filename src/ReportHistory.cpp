@@ -0,0 +1,185 @@
+#include "../headers/ReportHistory.h"
+#include "../headers/BinaryIO.h"
+
+/**
+ * @file ReportHistory.cpp
+ * @brief Appending to, reading from and serializing the columnar report history.
+ */
+
+void ReportHistory::widen(size_t cols) {
+    if (cols <= stride_) return;
+    std::vector<std::int32_t> carsM(size() * cols, 0);
+    std::vector<double> revenueM(size() * cols, 0.0);
+    for (size_t d = 0; d < size(); ++d) {
+        for (size_t k = 0; k < stride_; ++k) {
+            carsM[d * cols + k] = serviceCars_[d * stride_ + k];
+            revenueM[d * cols + k] = serviceRevenue_[d * stride_ + k];
+        }
+    }
+    serviceCars_.swap(carsM);
+    serviceRevenue_.swap(revenueM);
+    stride_ = cols;
+}
+
+/**
+ * @brief Appends a finalized report as one row of every column.
+ *
+ * Reports sharing this history's key table (or a newer one extending it) are copied by key;
+ * reports from another table are matched by service name.
+ *
+ * @param rep Report to store.
+ */
+void ReportHistory::append(const DailyReport &rep) {
+    const std::vector<ServiceStats> &stats = rep.perService();
+    std::vector<ServiceKey> column(stats.size());
+
+    const ServiceKeys &theirs = rep.keys();
+    bool sameKeys = rep.sharedKeys() == keys_;
+    if (!sameKeys && theirs.size() >= keys_->size()) {
+        // a newer table of the same simulation extends ours; adopt it if the prefix matches
+        sameKeys = true;
+        for (size_t k = 0; k < keys_->size() && sameKeys; ++k) {
+            sameKeys = keys_->name(static_cast<ServiceKey>(k)) == theirs.name(static_cast<ServiceKey>(k));
+        }
+        if (sameKeys) keys_ = rep.sharedKeys();
+    }
+    if (sameKeys) {
+        for (size_t k = 0; k < stats.size(); ++k) column[k] = static_cast<ServiceKey>(k);
+    } else {
+        auto extended = std::make_shared<ServiceKeys>(*keys_);
+        for (size_t k = 0; k < stats.size(); ++k) column[k] = extended->intern(theirs.name(static_cast<ServiceKey>(k)));
+        keys_ = std::move(extended);
+    }
+    widen(keys_->size());
+
+    day_.push_back(rep.day());
+    cars_.push_back(rep.totalCars());
+    lost_.push_back(rep.lostCustomers());
+    revenue_.push_back(rep.totalRevenue());
+    satisfaction_.push_back(rep.avgSatisfaction());
+
+    const size_t row = serviceCars_.size();
+    serviceCars_.resize(row + stride_, 0);
+    serviceRevenue_.resize(row + stride_, 0.0);
+    for (size_t k = 0; k < stats.size(); ++k) {
+        serviceCars_[row + column[k]] += stats[k].cars;
+        serviceRevenue_[row + column[k]] += stats[k].revenue;
+    }
+}
+
+DailyReport ReportHistory::at(size_t i) const {
+    DailyReport rep;
+    rep.beginDay(day_[i]);
+    rep.setKeys(keys_);
+    for (size_t k = 0; k < stride_; ++k) {
+        const ServiceStats st{serviceCars_[i * stride_ + k], serviceRevenue_[i * stride_ + k]};
+        if (st.cars != 0 || st.revenue != 0.0) rep.addServiceStats(static_cast<ServiceKey>(k), st);
+    }
+    rep.finalize(cars_[i], lost_[i], satisfaction_[i], revenue_[i]);
+    return rep;
+}
+
+ReportHistory ReportHistory::slice(size_t from) const {
+    ReportHistory out;
+    if (from >= size()) {
+        out.keys_ = keys_;
+        return out;
+    }
+    const auto first = static_cast<std::ptrdiff_t>(from);
+    out.day_.assign(day_.begin() + first, day_.end());
+    out.cars_.assign(cars_.begin() + first, cars_.end());
+    out.lost_.assign(lost_.begin() + first, lost_.end());
+    out.revenue_.assign(revenue_.begin() + first, revenue_.end());
+    out.satisfaction_.assign(satisfaction_.begin() + first, satisfaction_.end());
+    out.keys_ = keys_;
+    out.stride_ = stride_;
+    const auto cell = static_cast<std::ptrdiff_t>(from * stride_);
+    out.serviceCars_.assign(serviceCars_.begin() + cell, serviceCars_.end());
+    out.serviceRevenue_.assign(serviceRevenue_.begin() + cell, serviceRevenue_.end());
+    return out;
+}
+
+void ReportHistory::save(BinaryWriter &w) const {
+    saveLayout(w);
+    w.u32(static_cast<std::uint32_t>(size()));
+    for (size_t d = 0; d < size(); ++d) {
+        w.i32(day_[d]);
+        w.i32(cars_[d]);
+        w.i32(lost_[d]);
+        w.f64(revenue_[d]);
+        w.f64(satisfaction_[d]);
+        for (size_t k = 0; k < stride_; ++k) {
+            w.i32(serviceCars_[d * stride_ + k]);
+            w.f64(serviceRevenue_[d * stride_ + k]);
+        }
+    }
+}
+
+void ReportHistory::load(BinaryReader &r) {
+    loadLayout(r);
+    const size_t days = r.count(28 + stride_ * 12);
+    day_.reserve(days);
+    serviceCars_.reserve(days * stride_);
+    serviceRevenue_.reserve(days * stride_);
+    for (size_t d = 0; d < days; ++d) {
+        day_.push_back(r.i32());
+        cars_.push_back(r.i32());
+        lost_.push_back(r.i32());
+        revenue_.push_back(r.f64());
+        satisfaction_.push_back(r.f64());
+        for (size_t k = 0; k < stride_; ++k) {
+            serviceCars_.push_back(r.i32());
+            serviceRevenue_.push_back(r.f64());
+        }
+    }
+}
+
+void ReportHistory::saveLayout(BinaryWriter &w) const {
+    w.u32(static_cast<std::uint32_t>(keys_->size()));
+    for (size_t k = 0; k < keys_->size(); ++k) w.str(keys_->name(static_cast<ServiceKey>(k)));
+    w.u32(static_cast<std::uint32_t>(stride_));
+}
+
+void ReportHistory::loadLayout(BinaryReader &r) {
+    auto keys = std::make_shared<ServiceKeys>();
+    const size_t names = r.count(4);
+    for (size_t k = 0; k < names; ++k) keys->intern(r.str());
+    const size_t stride = r.u32();
+    if (stride != keys->size()) throw SaveFileException("Istoric de rapoarte invalid");
+
+    *this = ReportHistory();
+    keys_ = std::move(keys);
+    stride_ = stride;
+}
+
+void ReportHistory::saveRows(BinaryWriter &w, size_t from) const {
+    for (size_t d = from; d < size(); ++d) {
+        w.i32(day_[d]);
+        w.i32(cars_[d]);
+        w.i32(lost_[d]);
+        w.f64(revenue_[d]);
+        w.f64(satisfaction_[d]);
+        w.u32(static_cast<std::uint32_t>(stride_));
+        for (size_t k = 0; k < stride_; ++k) {
+            w.i32(serviceCars_[d * stride_ + k]);
+            w.f64(serviceRevenue_[d * stride_ + k]);
+        }
+    }
+}
+
+void ReportHistory::loadRow(BinaryReader &r) {
+    day_.push_back(r.i32());
+    cars_.push_back(r.i32());
+    lost_.push_back(r.i32());
+    revenue_.push_back(r.f64());
+    satisfaction_.push_back(r.f64());
+    // randurile scrise inainte de adaugarea unui serviciu au mai putine coloane
+    const size_t cols = r.count(12);
+    if (cols > stride_) throw SaveFileException("Istoric de rapoarte invalid");
+    for (size_t k = 0; k < cols; ++k) {
+        serviceCars_.push_back(r.i32());
+        serviceRevenue_.push_back(r.f64());
+    }
+    serviceCars_.resize(serviceCars_.size() + stride_ - cols, 0);
+    serviceRevenue_.resize(serviceRevenue_.size() + stride_ - cols, 0.0);
+}
@@ -1,21 +1,72 @@
 #include "../headers/ReputationManager.h"
 
 #include "../headers/MathUtils.h"
+#include "../headers/BinaryIO.h"
 
 #include <algorithm>
+#include <cmath>
 
-void ReputationManager::onServed(double satisfaction) {
-    double sat = clampValue<double>(satisfaction, 0.0, 5.0);
+void ReputationBatch::served(double sat) noexcept {
+    sat = clampValue<double>(sat, 0.0, 5.0);
+    scale_ *= DECAY;
+    offset_ = DECAY * offset_ + WEIGHT * sat;
+    floor_ = DECAY * floor_ + WEIGHT * sat;
     satisfaction_.add(sat);
-    servedCount_.add(1);
+    ++outcomes_;
+}
 
-    events_++;
-    score_ = 0.8 * score_ + 0.2 * sat;
-    score_ = clampValue<double>(score_, 0.0, 5.0);
+void ReputationBatch::served(double sat, std::size_t k) {
+    if (k == 0) return;
+    if (k == 1) {
+        served(sat);
+        return;
+    }
+    sat = clampValue<double>(sat, 0.0, 5.0);
+    const double keep = std::pow(DECAY, static_cast<double>(k));
+    const double w = 1.0 - keep;
+    scale_ *= keep;
+    offset_ = keep * offset_ + w * sat;
+    floor_ = keep * floor_ + w * sat;
+    satisfaction_.add(sat, k);
+    outcomes_ += k;
+}
+
+void ReputationBatch::lost(std::size_t m) noexcept {
+    if (m == 0) return;
+    const double penalty = LOSS_PENALTY * static_cast<double>(m);
+    offset_ -= penalty;
+    floor_ = std::max(0.0, floor_ - penalty);
+    outcomes_ += m;
+}
+
+double ReputationBatch::apply(double score) const noexcept {
+    if (outcomes_ == 0) return score;
+    return clampValue<double>(std::max(floor_, scale_ * score + offset_), 0.0, 5.0);
 }
 
-void ReputationManager::onLost() {
-    events_++;
-    score_ -= 0.10;
+void ReputationManager::apply(const ReputationBatch &batch) {
+    score_ = batch.apply(score_);
+    events_ += static_cast<int>(batch.outcomes());
+    satisfaction_.merge(batch.satisfaction());
+    servedCount_.add(1, batch.satisfaction().count());
+}
+
+void ReputationManager::blendToward(double target, double weight) {
+    weight = clampValue<double>(weight, 0.0, 1.0);
+    score_ = (1.0 - weight) * score_ + weight * target;
     score_ = clampValue<double>(score_, 0.0, 5.0);
 }
+
+void ReputationManager::save(BinaryWriter &w) const {
+    w.f64(score_);
+    w.i32(events_);
+    satisfaction_.save(w);
+    servedCount_.save(w);
+}
+
+void ReputationManager::load(BinaryReader &r) {
+    score_ = r.f64();
+    events_ = r.i32();
+    satisfaction_.load(r);
+    servedCount_.load(r);
+}
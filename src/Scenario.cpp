@@ -0,0 +1,59 @@
+#include "../headers/Scenario.h"
+#include "../headers/CarWash.h"
+#include "../headers/ServiceFactory.h"
+
+#include <utility>
+
+Scenario::Scenario(std::string name, Inventory inv, int openM, int closeM)
+    : name_(std::move(name)), inventory_(inv), openMin_(openM), closeMin_(closeM) {
+}
+
+Scenario Scenario::makeDefault() {
+    const int OPEN = 8 * 60;
+    const int CLOSE = 12 * 60;
+
+    Scenario sc("CarWash TYCOON", Inventory(3000, 2000, 1500), OPEN, CLOSE);
+
+    auto basicDefault = ServiceFactory::create("basic");
+    auto basicCfg = ServiceFactory::createConfigured(
+        ServiceFactory::Kind::Basic, "Basic", 20, 8.0, 80, 40, 0);
+
+    auto deluxeCfg = ServiceFactory::createConfigured(
+        ServiceFactory::Kind::Deluxe, "Deluxe", 35, 14.5, 120, 60, 0);
+
+    auto waxCfg = ServiceFactory::createConfigured(
+        ServiceFactory::Kind::Wax, "Wax", 25, 16.0, 60, 20, 50);
+
+    auto ecoCfg = ServiceFactory::createConfigured(
+        ServiceFactory::Kind::Eco, "Eco", 30, 12.0, 50, 30, 0);
+
+    if (!basicDefault || !basicCfg || !deluxeCfg || !waxCfg || !ecoCfg) {
+        throw CarWashException("ServiceFactory a returnat nullptr");
+    }
+
+    sc.addService(*basicDefault);
+    sc.addService(*basicCfg);
+    sc.addService(*deluxeCfg);
+    sc.addService(*waxCfg);
+    sc.addService(*ecoCfg);
+
+    sc.addBay(WashBay(1, OPEN, "B1"));
+    sc.addBay(WashBay(2, OPEN + 10, "B2"));
+    sc.addBay(WashBay(3, OPEN + 5, "B3"));
+    return sc;
+}
+
+std::unique_ptr<CarWash> Scenario::build(std::ostream *out) const {
+    auto game = std::make_unique<CarWash>(name_, inventory_, openMin_, closeMin_);
+    game->setOutput(out);
+
+    for (const auto &s: services_) {
+        if (s) game->addService(*s);
+    }
+    for (const auto &b: bays_) game->addBay(b);
+
+    if (startCash_ != 0.0) game->adjustCash(startCash_);
+    if (pricingMode_ != "balanced") game->setPricingMode(pricingMode_);
+    for (int id: upgrades_) game->buyUpgrade(id);
+    return game;
+}
@@ -0,0 +1,65 @@
+#include "../headers/ServiceChoiceIndex.h"
+#include "../headers/WashService.h"
+
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Runs the real chooseService of a stack-built customer of the given type.
+     */
+    const WashService *chooseWith(CustomerType type, double budget, const std::vector<WashService *> &services) {
+        switch (type) {
+            case CustomerType::Rushed: return RushedCustomer(0, budget, 1.0).chooseService(services);
+            case CustomerType::Budget: return BudgetCustomer(0, budget, 1.0).chooseService(services);
+            case CustomerType::Premium: return PremiumCustomer(0, budget, 1.0).chooseService(services);
+            case CustomerType::Eco: return EcoCustomer(0, budget, 1.0).chooseService(services);
+        }
+        return nullptr;
+    }
+} // namespace
+
+std::uint64_t ServiceChoiceIndex::revisionSum(const std::vector<WashService *> &services) {
+    std::uint64_t sum = 0;
+    for (const auto *s: services) {
+        if (s) sum += s->revision();
+    }
+    return sum;
+}
+
+void ServiceChoiceIndex::refresh(const std::vector<WashService *> &services) {
+    const std::uint64_t sum = revisionSum(services);
+    if (valid_ && serviceCount_ == services.size() && revisionSum_ == sum) return;
+    rebuild(services);
+    serviceCount_ = services.size();
+    revisionSum_ = sum;
+    valid_ = true;
+}
+
+void ServiceChoiceIndex::rebuild(const std::vector<WashService *> &services) {
+    std::vector<double> prices;
+    prices.reserve(services.size());
+    for (const auto *s: services) {
+        if (s) prices.push_back(s->price());
+    }
+    std::sort(prices.begin(), prices.end());
+    prices.erase(std::unique(prices.begin(), prices.end()), prices.end());
+
+    for (size_t t = 0; t < tables_.size(); ++t) {
+        Table &table = tables_[t];
+        table.breaks = prices;
+        table.choice.clear();
+        table.choice.reserve(prices.size());
+        for (double p: prices) {
+            const WashService *chosen = chooseWith(static_cast<CustomerType>(t), p, services);
+            const auto it = std::find(services.begin(), services.end(), chosen);
+            table.choice.push_back(chosen && it != services.end() ? static_cast<int>(it - services.begin()) : -1);
+        }
+    }
+}
+
+int ServiceChoiceIndex::choose(CustomerType type, double budget) const {
+    const Table &table = tables_[static_cast<size_t>(type)];
+    const auto it = std::upper_bound(table.breaks.begin(), table.breaks.end(), budget);
+    if (it == table.breaks.begin()) return -1;
+    return table.choice[static_cast<size_t>(it - table.breaks.begin()) - 1];
+}
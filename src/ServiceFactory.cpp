@@ -4,6 +4,7 @@
 #include "../headers/DeluxeService.h"
 #include "../headers/WaxService.h"
 #include "../headers/EcoService.h"
+#include "../headers/BinaryIO.h"
 
 static bool ieq(const std::string &a, const std::string &b) {
     if (a.size() != b.size()) return false;
@@ -52,3 +53,34 @@ std::unique_ptr<WashService> ServiceFactory::createConfigured(
     }
     return nullptr;
 }
+
+std::unique_ptr<WashService> ServiceFactory::load(BinaryReader &r) {
+    const auto kind = static_cast<ServiceKind>(r.u8());
+    std::string name = r.str();
+    const int duration = r.i32();
+    const double price = r.f64();
+    const int water = r.i32();
+    const int shampoo = r.i32();
+    const int wax = r.i32();
+    const double rating = r.f64();
+
+    switch (kind) {
+        case ServiceKind::Basic:
+            return createConfigured(Kind::Basic, std::move(name), duration, price, water, shampoo, wax, rating);
+        case ServiceKind::Deluxe:
+            return createConfigured(Kind::Deluxe, std::move(name), duration, price, water, shampoo, wax, rating);
+        case ServiceKind::Eco:
+            return createConfigured(Kind::Eco, std::move(name), duration, price, water, shampoo, wax, rating);
+        case ServiceKind::Wax: {
+            auto svc = std::make_unique<WaxService>(std::move(name), duration, price, water, shampoo, wax, rating);
+            const bool nano = r.boolean();
+            const double basePrice = r.f64();
+            const double baseRating = r.f64();
+            svc->restoreCoating(nano, basePrice, baseRating);
+            return svc;
+        }
+        case ServiceKind::Custom:
+            break;
+    }
+    throw SaveFileException("Tip de serviciu invalid in salvare");
+}
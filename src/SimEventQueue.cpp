@@ -0,0 +1,57 @@
+#include "../headers/SimEventQueue.h"
+#include "../headers/BinaryIO.h"
+
+#include <algorithm>
+
+/**
+ * @brief Heap comparator: true if a must be processed after b.
+ */
+bool SimEventQueue::later(const SimEvent &a, const SimEvent &b) noexcept {
+    if (a.minute != b.minute) return a.minute > b.minute;
+    if (a.type != b.type) return static_cast<int>(a.type) > static_cast<int>(b.type);
+    return a.seq > b.seq;
+}
+
+void SimEventQueue::schedule(int minute, SimEventType type, int payload) {
+    heap_.push_back(SimEvent{minute, type, payload, nextSeq_++});
+    std::push_heap(heap_.begin(), heap_.end(), later);
+}
+
+SimEvent SimEventQueue::pop() {
+    std::pop_heap(heap_.begin(), heap_.end(), later);
+    SimEvent ev = heap_.back();
+    heap_.pop_back();
+    return ev;
+}
+
+/**
+ * @brief Writes the heap as stored; the heap order stays valid after load().
+ */
+void SimEventQueue::save(BinaryWriter &w) const {
+    w.u64(nextSeq_);
+    w.u32(static_cast<std::uint32_t>(heap_.size()));
+    for (const auto &ev: heap_) {
+        w.i32(ev.minute);
+        w.u8(static_cast<std::uint8_t>(ev.type));
+        w.i32(ev.payload);
+        w.u64(ev.seq);
+    }
+}
+
+void SimEventQueue::load(BinaryReader &r) {
+    nextSeq_ = r.u64();
+    const size_t n = r.count(17);
+    heap_.clear();
+    heap_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        SimEvent ev;
+        ev.minute = r.i32();
+        const std::uint8_t type = r.u8();
+        if (type > static_cast<std::uint8_t>(SimEventType::DayEnd)) throw SaveFileException("Eveniment invalid");
+        ev.type = static_cast<SimEventType>(type);
+        ev.payload = r.i32();
+        ev.seq = r.u64();
+        heap_.push_back(ev);
+    }
+    if (!std::is_heap(heap_.begin(), heap_.end(), later)) throw SaveFileException("Coada de evenimente corupta");
+}
@@ -1,23 +1,35 @@
 #include "../headers/Statistics.h"
 
-#include <algorithm>
 #include <iomanip>
-#include <numeric>
 #include <ostream>
 #include <vector>
 
 /**
  * @file Statistics.cpp
- * @brief Implements advanced analytics over a sequence of DailyReport objects.
+ * @brief Implements advanced analytics over the columnar report history.
  */
 
 /**
- * @brief Constructs a Statistics instance from a list of daily reports.
+ * @brief Constructs a Statistics view over a shared history and its running aggregate.
+ *
+ * @param history Reports to analyze.
+ * @param agg Aggregate maintained alongside history.
+ * @param streaming Streaming analytics maintained alongside history.
+ */
+Statistics::Statistics(std::shared_ptr<const ReportHistory> history, StatsAggregator agg, StreamingStats streaming)
+    : history_(std::move(history)), agg_(std::move(agg)), streaming_(std::move(streaming)) {
+}
+
+/**
+ * @brief Constructs a Statistics instance from a standalone history.
  *
  * @param reps Reports to analyze. Ownership is moved into the Statistics object.
  */
-Statistics::Statistics(std::vector<DailyReport> reps)
-    : reports_(std::move(reps)) {
+Statistics::Statistics(ReportHistory reps)
+    : history_(std::make_shared<const ReportHistory>(std::move(reps))), agg_(StatsAggregator::scan(*history_)) {
+    for (size_t i = 0; i < history_->size(); ++i) {
+        streaming_.addDay(history_->revenue()[i], history_->lost()[i], history_->satisfaction()[i]);
+    }
 }
 
 /**
@@ -38,7 +50,7 @@ double Statistics::safeDiv(double a, double b) {
  * @return Number of stored DailyReport entries.
  */
 int Statistics::days() const noexcept {
-    return static_cast<int>(reports_.size());
+    return agg_.days();
 }
 
 /**
@@ -47,9 +59,7 @@ int Statistics::days() const noexcept {
  * @return Sum of totalCars() across all days.
  */
 int Statistics::totalCars() const noexcept {
-    int sum = 0;
-    for (const auto &r: reports_) sum += r.totalCars();
-    return sum;
+    return agg_.totalCars();
 }
 
 /**
@@ -58,9 +68,7 @@ int Statistics::totalCars() const noexcept {
  * @return Sum of lostCustomers() across all days.
  */
 int Statistics::totalLost() const noexcept {
-    int sum = 0;
-    for (const auto &r: reports_) sum += r.lostCustomers();
-    return sum;
+    return agg_.totalLost();
 }
 
 /**
@@ -69,9 +77,7 @@ int Statistics::totalLost() const noexcept {
  * @return Sum of totalRevenue() across all days.
  */
 double Statistics::totalRevenue() const noexcept {
-    double sum = 0.0;
-    for (const auto &r: reports_) sum += r.totalRevenue();
-    return sum;
+    return agg_.totalRevenue();
 }
 
 /**
@@ -109,14 +115,7 @@ double Statistics::avgRevenuePerDay() const noexcept {
  * @return Weighted average satisfaction (0 if total weight is zero).
  */
 double Statistics::avgSatisfactionWeighted() const noexcept {
-    double weighted = 0.0;
-    double weight = 0.0;
-    for (const auto &r: reports_) {
-        const double w = static_cast<double>(r.totalCars());
-        weighted += r.avgSatisfaction() * w;
-        weight += w;
-    }
-    return safeDiv(weighted, weight);
+    return safeDiv(agg_.weightedSatisfaction(), agg_.satisfactionWeight());
 }
 
 /**
@@ -125,12 +124,7 @@ double Statistics::avgSatisfactionWeighted() const noexcept {
  * @return Day number of the best revenue day; 0 if no reports exist.
  */
 int Statistics::bestDayByRevenue() const noexcept {
-    if (reports_.empty()) return 0;
-    auto it = std::max_element(reports_.begin(), reports_.end(),
-                               [](const DailyReport &a, const DailyReport &b) {
-                                   return a.totalRevenue() < b.totalRevenue();
-                               });
-    return it->day();
+    return agg_.maxRevenue().day;
 }
 
 /**
@@ -139,12 +133,7 @@ int Statistics::bestDayByRevenue() const noexcept {
  * @return Day number of the worst revenue day; 0 if no reports exist.
  */
 int Statistics::worstDayByRevenue() const noexcept {
-    if (reports_.empty()) return 0;
-    auto it = std::min_element(reports_.begin(), reports_.end(),
-                               [](const DailyReport &a, const DailyReport &b) {
-                                   return a.totalRevenue() < b.totalRevenue();
-                               });
-    return it->day();
+    return agg_.minRevenue().day;
 }
 
 /**
@@ -153,12 +142,7 @@ int Statistics::worstDayByRevenue() const noexcept {
  * @return Day number of the best satisfaction day; 0 if no reports exist.
  */
 int Statistics::bestDayBySatisfaction() const noexcept {
-    if (reports_.empty()) return 0;
-    auto it = std::max_element(reports_.begin(), reports_.end(),
-                               [](const DailyReport &a, const DailyReport &b) {
-                                   return a.avgSatisfaction() < b.avgSatisfaction();
-                               });
-    return it->day();
+    return agg_.maxSatisfaction().day;
 }
 
 /**
@@ -167,12 +151,7 @@ int Statistics::bestDayBySatisfaction() const noexcept {
  * @return Day number of the worst satisfaction day; 0 if no reports exist.
  */
 int Statistics::worstDayBySatisfaction() const noexcept {
-    if (reports_.empty()) return 0;
-    auto it = std::min_element(reports_.begin(), reports_.end(),
-                               [](const DailyReport &a, const DailyReport &b) {
-                                   return a.avgSatisfaction() < b.avgSatisfaction();
-                               });
-    return it->day();
+    return agg_.minSatisfaction().day;
 }
 
 /**
@@ -181,12 +160,7 @@ int Statistics::worstDayBySatisfaction() const noexcept {
  * @return Day number of the best (lowest lost) day; 0 if no reports exist.
  */
 int Statistics::bestDayByLost() const noexcept {
-    if (reports_.empty()) return 0;
-    auto it = std::min_element(reports_.begin(), reports_.end(),
-                               [](const DailyReport &a, const DailyReport &b) {
-                                   return a.lostCustomers() < b.lostCustomers();
-                               });
-    return it->day();
+    return agg_.minLost().day;
 }
 
 /**
@@ -195,34 +169,7 @@ int Statistics::bestDayByLost() const noexcept {
  * @return Day number of the worst (highest lost) day; 0 if no reports exist.
  */
 int Statistics::worstDayByLost() const noexcept {
-    if (reports_.empty()) return 0;
-    auto it = std::max_element(reports_.begin(), reports_.end(),
-                               [](const DailyReport &a, const DailyReport &b) {
-                                   return a.lostCustomers() < b.lostCustomers();
-                               });
-    return it->day();
-}
-
-/**
- * @brief Aggregates per-service statistics across a set of reports.
- *
- * For each service name, this function sums total cars and total revenue.
- *
- * @param reps Reports to aggregate.
- * @return Map from service name to aggregated metrics.
- */
-std::map<std::string, ServiceAggregate> Statistics::aggregateServices(const std::vector<DailyReport> &reps) {
-    std::map<std::string, ServiceAggregate> agg;
-    for (const auto &r: reps) {
-        for (const auto &kv: r.perService()) {
-            const auto &name = kv.first;
-            const auto &st = kv.second;
-            auto &a = agg[name];
-            a.cars += st.cars;
-            a.revenue += st.revenue;
-        }
-    }
-    return agg;
+    return agg_.maxLost().day;
 }
 
 /**
@@ -232,13 +179,7 @@ std::map<std::string, ServiceAggregate> Statistics::aggregateServices(const std:
  * @return Vector of (serviceName, aggregate) pairs sorted by revenue desc.
  */
 std::vector<std::pair<std::string, ServiceAggregate> > Statistics::topServicesByRevenue(int k) const {
-    if (k <= 0) return {};
-    auto agg = aggregateServices(reports_);
-    std::vector<std::pair<std::string, ServiceAggregate> > v(agg.begin(), agg.end());
-    std::sort(v.begin(), v.end(),
-              [](const auto &a, const auto &b) { return a.second.revenue > b.second.revenue; });
-    if (static_cast<int>(v.size()) > k) v.resize(static_cast<size_t>(k));
-    return v;
+    return agg_.topByRevenue(k);
 }
 
 /**
@@ -248,60 +189,47 @@ std::vector<std::pair<std::string, ServiceAggregate> > Statistics::topServicesBy
  * @return Vector of (serviceName, aggregate) pairs sorted by cars desc.
  */
 std::vector<std::pair<std::string, ServiceAggregate> > Statistics::topServicesByCars(int k) const {
-    if (k <= 0) return {};
-    auto agg = aggregateServices(reports_);
-    std::vector<std::pair<std::string, ServiceAggregate> > v(agg.begin(), agg.end());
-    std::sort(v.begin(), v.end(),
-              [](const auto &a, const auto &b) { return a.second.cars > b.second.cars; });
-    if (static_cast<int>(v.size()) > k) v.resize(static_cast<size_t>(k));
-    return v;
+    return agg_.topByCars(k);
 }
 
 /**
  * @brief Returns a revenue time series aligned with the report order.
  *
- * @return Vector of daily revenue values.
+ * @return Daily revenue column (no copy).
  */
-std::vector<double> Statistics::revenueSeries() const {
-    std::vector<double> s;
-    s.reserve(reports_.size());
-    for (const auto &r: reports_) s.push_back(r.totalRevenue());
-    return s;
+const std::vector<double> &Statistics::revenueSeries() const noexcept {
+    return history_->revenue();
 }
 
 /**
  * @brief Returns a satisfaction time series aligned with the report order.
  *
- * @return Vector of daily average satisfaction values.
+ * @return Daily average satisfaction column (no copy).
  */
-std::vector<double> Statistics::satisfactionSeries() const {
-    std::vector<double> s;
-    s.reserve(reports_.size());
-    for (const auto &r: reports_) s.push_back(r.avgSatisfaction());
-    return s;
+const std::vector<double> &Statistics::satisfactionSeries() const noexcept {
+    return history_->satisfaction();
 }
 
 /**
  * @brief Returns a lost-customers time series aligned with the report order.
  *
- * @return Vector of daily lost customer counts.
+ * @return Daily lost customers column (no copy).
  */
-std::vector<int> Statistics::lostSeries() const {
-    std::vector<int> s;
-    s.reserve(reports_.size());
-    for (const auto &r: reports_) s.push_back(r.lostCustomers());
-    return s;
+const std::vector<std::int32_t> &Statistics::lostSeries() const noexcept {
+    return history_->lost();
 }
 
 /**
- * @brief Prints a detailed statistics report to an output stream.
+ * @brief Prints the aggregate part of the statistics report.
  *
- * The report includes totals, averages, best/worst days, min/max values and simple
- * trend estimates based on (last - first) over the series.
+ * Includes totals, averages, best/worst days, min/max values, simple trend estimates
+ * based on (last - first) over the series and the top services, but not the per-day
+ * series. Everything comes from the aggregate, so the cost does not grow with the
+ * number of days.
  *
  * @param os Output stream.
  */
-void Statistics::print(std::ostream &os) const {
+void Statistics::printSummary(std::ostream &os) const {
     os << "=== STATISTICS ===\n";
     os << "Days: " << days() << "\n";
     os << "Total cars: " << totalCars() << "\n";
@@ -319,31 +247,19 @@ void Statistics::print(std::ostream &os) const {
     os << "Best day by lost: " << bestDayByLost() << "\n";
     os << "Worst day by lost: " << worstDayByLost() << "\n";
 
-    const auto rev = revenueSeries();
-    const auto sat = satisfactionSeries();
-    const auto lost = lostSeries();
-
-    auto minmaxRev = std::minmax_element(rev.begin(), rev.end());
-    auto minmaxSat = std::minmax_element(sat.begin(), sat.end());
-    auto minmaxLost = std::minmax_element(lost.begin(), lost.end());
-
-    const double revTrend = (rev.size() >= 2) ? (rev.back() - rev.front()) : 0.0;
-    const double satTrend = (sat.size() >= 2) ? (sat.back() - sat.front()) : 0.0;
-    const int lostTrend = (lost.size() >= 2) ? (lost.back() - lost.front()) : 0;
-
     os << "Revenue min/max: "
             << std::setprecision(2)
-            << (rev.empty() ? 0.0 : *minmaxRev.first) << " / " << (rev.empty() ? 0.0 : *minmaxRev.second)
-            << " | trend=" << revTrend << "\n";
+            << agg_.minRevenue().value << " / " << agg_.maxRevenue().value
+            << " | trend=" << agg_.revenueTrend() << "\n";
 
     os << "Satisfaction min/max: "
             << std::setprecision(3)
-            << (sat.empty() ? 0.0 : *minmaxSat.first) << " / " << (sat.empty() ? 0.0 : *minmaxSat.second)
-            << " | trend=" << satTrend << "\n";
+            << agg_.minSatisfaction().value << " / " << agg_.maxSatisfaction().value
+            << " | trend=" << agg_.satisfactionTrend() << "\n";
 
     os << "Lost min/max: "
-            << (lost.empty() ? 0 : *minmaxLost.first) << " / " << (lost.empty() ? 0 : *minmaxLost.second)
-            << " | trend=" << lostTrend << "\n";
+            << agg_.minLost().value << " / " << agg_.maxLost().value
+            << " | trend=" << agg_.lostTrend() << "\n";
 
     os << "Top services by revenue:\n";
     for (const auto &p: topServicesByRevenue(5)) {
@@ -356,12 +272,58 @@ void Statistics::print(std::ostream &os) const {
         os << "  - " << p.first << ": cars=" << p.second.cars
                 << " revenue=" << std::setprecision(2) << p.second.revenue << "\n";
     }
+}
+
+namespace {
+    void printMetric(std::ostream &os, const char *label, const StreamingStats::Metric &m, int precision) {
+        os << "  " << label << ": " << std::setprecision(precision);
+        for (size_t i = 0; i < m.windows.size(); ++i) os << (i ? " / " : "") << m.windows[i].mean();
+        os << " | ewma=" << m.ewma.value() << "\n";
+    }
+
+    void printBand(std::ostream &os, const char *label, const QuantileBand &b, int precision) {
+        os << label << " p10/p50/p90: ";
+        if (b.count() == 0) {
+            os << "n/a\n";
+            return;
+        }
+        os << std::setprecision(precision) << b.p10.value() << " / " << b.p50.value() << " / " << b.p90.value()
+                << " (n=" << b.count() << ")\n";
+    }
+} // namespace
+
+/**
+ * @brief Prints the streaming analytics (moving windows, EWMAs, quantile estimates).
+ *
+ * @param os Output stream.
+ */
+void Statistics::printTrends(std::ostream &os) const {
+    os << std::fixed << "Moving averages (";
+    for (size_t i = 0; i < StreamingStats::WINDOWS.size(); ++i) os << (i ? "/" : "") << StreamingStats::WINDOWS[i];
+    os << " days):\n";
+    printMetric(os, "revenue", streaming_.revenue(), 2);
+    printMetric(os, "lost", streaming_.lost(), 2);
+    printMetric(os, "satisfaction", streaming_.satisfaction(), 3);
+    printBand(os, "Daily revenue", streaming_.dailyRevenue(), 2);
+    printBand(os, "Customer satisfaction", streaming_.customerSatisfaction(), 3);
+}
+
+/**
+ * @brief Prints a detailed statistics report to an output stream.
+ *
+ * The summary (see printSummary), the streaming analytics, then the per-day series.
+ *
+ * @param os Output stream.
+ */
+void Statistics::print(std::ostream &os) const {
+    printSummary(os);
+    printTrends(os);
 
     os << "Series (day -> revenue, sat, lost):\n";
-    for (const auto &r: reports_) {
-        os << "  day " << r.day() << " -> "
-                << std::setprecision(2) << r.totalRevenue() << ", "
-                << std::setprecision(3) << r.avgSatisfaction() << ", "
-                << r.lostCustomers() << "\n";
+    for (size_t i = 0; i < history_->size(); ++i) {
+        os << "  day " << history_->days()[i] << " -> "
+                << std::setprecision(2) << history_->revenue()[i] << ", "
+                << std::setprecision(3) << history_->satisfaction()[i] << ", "
+                << history_->lost()[i] << "\n";
     }
 }
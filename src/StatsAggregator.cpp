@@ -0,0 +1,137 @@
+#include "../headers/StatsAggregator.h"
+#include "../headers/ReportHistory.h"
+#include "../headers/Reductions.h"
+
+#include <algorithm>
+#include <functional>
+
+/**
+ * @file StatsAggregator.cpp
+ * @brief Per-day update of the running statistics and the top-k service ranking.
+ */
+
+namespace {
+    /**
+     * @brief Keeps the first day on which the largest (under better) value was seen.
+     */
+    template<typename T, typename Better>
+    void track(StatsAggregator::Extreme<T> &e, T value, int day, bool first, Better better) {
+        if (first || better(value, e.value)) e = {value, day};
+    }
+
+    /**
+     * @brief Services that sold at least once, ordered by rank (ties by name), cut to k.
+     */
+    template<typename Rank>
+    std::vector<std::pair<std::string, ServiceAggregate> > topK(const std::vector<ServiceAggregate> &services,
+                                                                 const ServiceKeys &keys, int k, Rank rank) {
+        if (k <= 0) return {};
+        std::vector<std::pair<std::string, ServiceAggregate> > v;
+        v.reserve(services.size());
+        for (size_t key = 0; key < services.size(); ++key) {
+            if (services[key].cars != 0) v.emplace_back(keys.name(static_cast<ServiceKey>(key)), services[key]);
+        }
+        const auto order = [&](const auto &a, const auto &b) {
+            const auto ra = rank(a.second);
+            const auto rb = rank(b.second);
+            return ra != rb ? ra > rb : a.first < b.first;
+        };
+        const size_t n = std::min(v.size(), static_cast<size_t>(k));
+        std::partial_sort(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(n), v.end(), order);
+        v.resize(n);
+        return v;
+    }
+} // namespace
+
+StatsAggregator::StatsAggregator(const ReportHistory &history) {
+    for (size_t row = 0; row < history.size(); ++row) add(history, row);
+}
+
+StatsAggregator StatsAggregator::scan(const ReportHistory &history, ThreadPool *pool) {
+    StatsAggregator a;
+    a.keys_ = history.sharedKeys();
+    a.services_.resize(history.serviceColumns());
+    if (history.empty()) return a;
+
+    const auto &days = history.days();
+    a.days_ = static_cast<int>(history.size());
+    a.totalCars_ = static_cast<int>(Reductions::sum(history.cars(), pool));
+    a.totalLost_ = static_cast<int>(Reductions::sum(history.lost(), pool));
+    a.totalRevenue_ = Reductions::kahanSum(history.revenue(), pool);
+    a.satWeight_ = static_cast<double>(a.totalCars_);
+    a.weightedSat_ = Reductions::weightedMean(history.satisfaction(), history.cars(), pool) * a.satWeight_;
+
+    const auto revenue = Reductions::extremes(history.revenue(), pool);
+    const auto sat = Reductions::extremes(history.satisfaction(), pool);
+    const auto lost = Reductions::extremes(history.lost(), pool);
+    a.maxRevenue_ = {revenue.max, days[revenue.argMax]};
+    a.minRevenue_ = {revenue.min, days[revenue.argMin]};
+    a.maxSat_ = {sat.max, days[sat.argMax]};
+    a.minSat_ = {sat.min, days[sat.argMin]};
+    a.maxLost_ = {lost.max, days[lost.argMax]};
+    a.minLost_ = {lost.min, days[lost.argMin]};
+
+    a.firstRevenue_ = history.revenue().front();
+    a.lastRevenue_ = history.revenue().back();
+    a.firstSat_ = history.satisfaction().front();
+    a.lastSat_ = history.satisfaction().back();
+    a.firstLost_ = history.lost().front();
+    a.lastLost_ = history.lost().back();
+
+    for (size_t row = 0; row < history.size(); ++row) {
+        for (size_t k = 0; k < history.serviceColumns(); ++k) {
+            const auto key = static_cast<ServiceKey>(k);
+            a.services_[k].cars += history.serviceCars(row, key);
+            a.services_[k].revenue += history.serviceRevenue(row, key);
+        }
+    }
+    return a;
+}
+
+void StatsAggregator::add(const ReportHistory &history, size_t row) {
+    const int day = history.days()[row];
+    const int cars = history.cars()[row];
+    const int lost = history.lost()[row];
+    const double revenue = history.revenue()[row];
+    const double sat = history.satisfaction()[row];
+    const bool first = days_ == 0;
+
+    ++days_;
+    totalCars_ += cars;
+    totalLost_ += lost;
+    totalRevenue_ += revenue;
+    weightedSat_ += sat * static_cast<double>(cars);
+    satWeight_ += static_cast<double>(cars);
+
+    track(maxRevenue_, revenue, day, first, std::greater<>());
+    track(minRevenue_, revenue, day, first, std::less<>());
+    track(maxSat_, sat, day, first, std::greater<>());
+    track(minSat_, sat, day, first, std::less<>());
+    track(maxLost_, lost, day, first, std::greater<>());
+    track(minLost_, lost, day, first, std::less<>());
+
+    if (first) {
+        firstRevenue_ = revenue;
+        firstSat_ = sat;
+        firstLost_ = lost;
+    }
+    lastRevenue_ = revenue;
+    lastSat_ = sat;
+    lastLost_ = lost;
+
+    keys_ = history.sharedKeys();
+    if (services_.size() < history.serviceColumns()) services_.resize(history.serviceColumns());
+    for (size_t k = 0; k < history.serviceColumns(); ++k) {
+        const auto key = static_cast<ServiceKey>(k);
+        services_[k].cars += history.serviceCars(row, key);
+        services_[k].revenue += history.serviceRevenue(row, key);
+    }
+}
+
+std::vector<std::pair<std::string, ServiceAggregate> > StatsAggregator::topByRevenue(int k) const {
+    return topK(services_, *keys_, k, [](const ServiceAggregate &a) { return a.revenue; });
+}
+
+std::vector<std::pair<std::string, ServiceAggregate> > StatsAggregator::topByCars(int k) const {
+    return topK(services_, *keys_, k, [](const ServiceAggregate &a) { return a.cars; });
+}
@@ -0,0 +1,204 @@
+#include "../headers/StreamingStats.h"
+#include "../headers/BinaryIO.h"
+
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @file StreamingStats.cpp
+ * @brief Moving windows, EWMA and P-square quantile sketches.
+ */
+
+RollingWindow::RollingWindow(size_t capacity)
+    : ring_(capacity, 0.0) {
+}
+
+void RollingWindow::add(double x) {
+    if (ring_.empty()) return;
+    if (full()) {
+        sum_ += x - ring_[head_];
+    } else {
+        sum_ += x;
+        ++count_;
+    }
+    ring_[head_] = x;
+    head_ = (head_ + 1) % ring_.size();
+    if (head_ == 0) sum_ = std::accumulate(ring_.begin(), ring_.end(), 0.0);
+}
+
+double RollingWindow::mean() const noexcept {
+    return count_ == 0 ? 0.0 : sum_ / static_cast<double>(count_);
+}
+
+double RollingWindow::min() const noexcept {
+    if (count_ == 0) return 0.0;
+    return *std::min_element(ring_.begin(), ring_.begin() + static_cast<std::ptrdiff_t>(count_));
+}
+
+double RollingWindow::max() const noexcept {
+    if (count_ == 0) return 0.0;
+    return *std::max_element(ring_.begin(), ring_.begin() + static_cast<std::ptrdiff_t>(count_));
+}
+
+void RollingWindow::save(BinaryWriter &w) const {
+    w.u32(static_cast<std::uint32_t>(count_));
+    w.u32(static_cast<std::uint32_t>(head_));
+    for (size_t i = 0; i < count_; ++i) w.f64(ring_[i]);
+}
+
+void RollingWindow::load(BinaryReader &r) {
+    const size_t count = r.count(8);
+    const size_t head = r.u32();
+    if (count > ring_.size() || (count < ring_.size() && head != count) || head >= std::max<size_t>(ring_.size(), 1)) {
+        throw SaveFileException("Fereastra statistica invalida");
+    }
+    std::fill(ring_.begin(), ring_.end(), 0.0);
+    for (size_t i = 0; i < count; ++i) ring_[i] = r.f64();
+    count_ = count;
+    head_ = head;
+    sum_ = std::accumulate(ring_.begin(), ring_.begin() + static_cast<std::ptrdiff_t>(count_), 0.0);
+}
+
+void Ewma::save(BinaryWriter &w) const {
+    w.f64(value_);
+    w.boolean(seeded_);
+}
+
+void Ewma::load(BinaryReader &r) {
+    value_ = r.f64();
+    seeded_ = r.boolean();
+}
+
+/**
+ * @brief Piecewise-parabolic prediction of marker i moved by d positions.
+ */
+double P2Quantile::parabolic(int i, double d) const noexcept {
+    const auto k = static_cast<size_t>(i);
+    return q_[k] + d / (n_[k + 1] - n_[k - 1]) *
+                   ((n_[k] - n_[k - 1] + d) * (q_[k + 1] - q_[k]) / (n_[k + 1] - n_[k]) +
+                    (n_[k + 1] - n_[k] - d) * (q_[k] - q_[k - 1]) / (n_[k] - n_[k - 1]));
+}
+
+/**
+ * @brief Linear fallback when the parabolic step would break marker ordering.
+ */
+double P2Quantile::linear(int i, int d) const noexcept {
+    const auto k = static_cast<size_t>(i);
+    const auto j = static_cast<size_t>(i + d);
+    return q_[k] + d * (q_[j] - q_[k]) / (n_[j] - n_[k]);
+}
+
+void P2Quantile::add(double x) {
+    if (count_ < 5) {
+        const auto end = q_.begin() + static_cast<std::ptrdiff_t>(count_);
+        const auto at = std::upper_bound(q_.begin(), end, x);
+        std::move_backward(at, end, end + 1);
+        *at = x;
+        if (++count_ == 5) {
+            n_ = {0.0, 1.0, 2.0, 3.0, 4.0};
+            want_ = {0.0, 2.0 * p_, 4.0 * p_, 2.0 + 2.0 * p_, 4.0};
+        }
+        return;
+    }
+
+    size_t k;
+    if (x < q_[0]) {
+        q_[0] = x;
+        k = 0;
+    } else if (x >= q_[4]) {
+        q_[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (x >= q_[k + 1]) ++k;
+    }
+    for (size_t i = k + 1; i < 5; ++i) n_[i] += 1.0;
+    const std::array<double, 5> step{0.0, p_ / 2.0, p_, (1.0 + p_) / 2.0, 1.0};
+    for (size_t i = 0; i < 5; ++i) want_[i] += step[i];
+    ++count_;
+
+    for (int i = 1; i <= 3; ++i) {
+        const auto m = static_cast<size_t>(i);
+        const double d = want_[m] - n_[m];
+        if ((d >= 1.0 && n_[m + 1] - n_[m] > 1.0) || (d <= -1.0 && n_[m - 1] - n_[m] < -1.0)) {
+            const int s = d > 0.0 ? 1 : -1;
+            const double candidate = parabolic(i, s);
+            q_[m] = q_[m - 1] < candidate && candidate < q_[m + 1] ? candidate : linear(i, s);
+            n_[m] += s;
+        }
+    }
+}
+
+double P2Quantile::value() const noexcept {
+    if (count_ == 0) return 0.0;
+    if (count_ >= 5) return q_[2];
+    // exact quantile (linear interpolation between closest ranks) of the few stored samples
+    const double pos = p_ * static_cast<double>(count_ - 1);
+    const auto lo = static_cast<size_t>(pos);
+    const size_t hi = std::min<size_t>(lo + 1, count_ - 1);
+    return q_[lo] + (q_[hi] - q_[lo]) * (pos - static_cast<double>(lo));
+}
+
+void P2Quantile::save(BinaryWriter &w) const {
+    w.u64(count_);
+    for (const auto *arr: {&q_, &n_, &want_}) {
+        for (double v: *arr) w.f64(v);
+    }
+}
+
+void P2Quantile::load(BinaryReader &r) {
+    count_ = r.u64();
+    for (auto *arr: {&q_, &n_, &want_}) {
+        for (double &v: *arr) v = r.f64();
+    }
+}
+
+void QuantileBand::save(BinaryWriter &w) const {
+    p10.save(w);
+    p50.save(w);
+    p90.save(w);
+}
+
+void QuantileBand::load(BinaryReader &r) {
+    p10.load(r);
+    p50.load(r);
+    p90.load(r);
+}
+
+void StreamingStats::Metric::add(double x) {
+    for (auto &win: windows) win.add(x);
+    ewma.add(x);
+}
+
+void StreamingStats::Metric::save(BinaryWriter &w) const {
+    for (const auto &win: windows) win.save(w);
+    ewma.save(w);
+}
+
+void StreamingStats::Metric::load(BinaryReader &r) {
+    for (auto &win: windows) win.load(r);
+    ewma.load(r);
+}
+
+void StreamingStats::addDay(double revenue, int lost, double avgSatisfaction) {
+    revenue_.add(revenue);
+    lost_.add(static_cast<double>(lost));
+    satisfaction_.add(avgSatisfaction);
+    dailyRevenue_.add(revenue);
+}
+
+void StreamingStats::save(BinaryWriter &w) const {
+    revenue_.save(w);
+    lost_.save(w);
+    satisfaction_.save(w);
+    dailyRevenue_.save(w);
+    customerSatisfaction_.save(w);
+}
+
+void StreamingStats::load(BinaryReader &r) {
+    revenue_.load(r);
+    lost_.load(r);
+    satisfaction_.load(r);
+    dailyRevenue_.load(r);
+    customerSatisfaction_.load(r);
+}
@@ -0,0 +1,135 @@
+#include "../headers/ThreadPool.h"
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+    blocks_ = std::make_unique<Block[]>(static_cast<size_t>(threads));
+    workers_.reserve(static_cast<size_t>(threads - 1));
+    for (int i = 1; i < threads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &t: workers_) t.join();
+}
+
+void ThreadPool::workerLoop(int self) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            wake_.wait(lk, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        drain(self);
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (--busy_ == 0) done_.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Pops the front index of the thread's own block.
+ */
+bool ThreadPool::takeOwn(int self, int &index) {
+    std::atomic<std::uint64_t> &range = blocks_[static_cast<size_t>(self)].range;
+    std::uint64_t r = range.load(std::memory_order_acquire);
+    while (true) {
+        const auto begin = static_cast<std::uint32_t>(r >> 32);
+        const auto end = static_cast<std::uint32_t>(r);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(r, pack(begin + 1, end), std::memory_order_acq_rel)) {
+            index = static_cast<int>(begin);
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Moves the back half of the largest other block into the thread's own block.
+ *
+ * @return false when no other thread has work left.
+ */
+bool ThreadPool::steal(int self) {
+    const int n = size();
+    while (true) {
+        int victim = -1;
+        std::uint32_t most = 0;
+        for (int v = 0; v < n; ++v) {
+            if (v == self) continue;
+            const std::uint64_t r = blocks_[static_cast<size_t>(v)].range.load(std::memory_order_acquire);
+            const auto begin = static_cast<std::uint32_t>(r >> 32);
+            const auto end = static_cast<std::uint32_t>(r);
+            if (end > begin && end - begin > most) {
+                most = end - begin;
+                victim = v;
+            }
+        }
+        if (victim < 0) return false;
+
+        std::atomic<std::uint64_t> &range = blocks_[static_cast<size_t>(victim)].range;
+        std::uint64_t r = range.load(std::memory_order_acquire);
+        const auto begin = static_cast<std::uint32_t>(r >> 32);
+        const auto end = static_cast<std::uint32_t>(r);
+        if (begin >= end) continue;
+        const std::uint32_t mid = begin + (end - begin) / 2;
+        if (range.compare_exchange_strong(r, pack(begin, mid), std::memory_order_acq_rel)) {
+            blocks_[static_cast<size_t>(self)].range.store(pack(mid, end), std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+void ThreadPool::drain(int self) {
+    int i = 0;
+    while (true) {
+        if (!takeOwn(self, i)) {
+            if (!steal(self)) return;
+            continue;
+        }
+        try {
+            (*job_)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(errorM_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(int n, const std::function<void(int)> &fn) {
+    if (n <= 0) return;
+    if (workers_.empty()) {
+        for (int i = 0; i < n; ++i) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        job_ = &fn;
+        const int parts = size();
+        for (int p = 0; p < parts; ++p) {
+            const auto begin = static_cast<std::uint32_t>(static_cast<std::int64_t>(n) * p / parts);
+            const auto end = static_cast<std::uint32_t>(static_cast<std::int64_t>(n) * (p + 1) / parts);
+            blocks_[static_cast<size_t>(p)].range.store(pack(begin, end), std::memory_order_relaxed);
+        }
+        busy_ = static_cast<int>(workers_.size());
+        error_ = nullptr;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lk(m_);
+    done_.wait(lk, [&] { return busy_ == 0; });
+    job_ = nullptr;
+    if (error_) std::rethrow_exception(error_);
+}
@@ -7,6 +7,14 @@ void Upgrade::print(std::ostream &os) const {
     os << name() << " | " << description() << " | cost=" << cost();
 }
 
+std::unique_ptr<Upgrade> Upgrade::create(int id) {
+    if (id == 1) return std::make_unique<BaySpeedUpgrade>();
+    if (id == 2) return std::make_unique<ComfortUpgrade>();
+    if (id == 3) return std::make_unique<MarketingUpgrade>();
+    if (id == 4) return std::make_unique<NanoCoatingUpgrade>();
+    return nullptr;
+}
+
 std::ostream &operator<<(std::ostream &os, const Upgrade &up) {
     up.print(os);
     return os;
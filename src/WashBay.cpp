@@ -1,9 +1,10 @@
 #include "../headers/WashBay.h"
-#include "../headers/WashService.h"
+#include "../headers/BinaryIO.h"
 #include <algorithm>
+#include <cmath>
 #include <ostream>
 
-int WashBay::bayCount_ = 0;
+std::atomic<int> WashBay::bayCount_{0};
 
 char *WashBay::dup(const std::string &s) {
     char *p = new char[s.size() + 1];
@@ -18,7 +19,7 @@ WashBay::WashBay(int id, int startMin, const std::string &text)
 
 WashBay::WashBay(const WashBay &o)
     : id_(o.id_), availMin_(o.availMin_), label_(dup(o.label_)),
-      canBasic_(o.canBasic_), canDeluxe_(o.canDeluxe_), canWax_(o.canWax_) {
+      caps_(o.caps_) {
 }
 
 WashBay &WashBay::operator=(const WashBay &o) {
@@ -27,9 +28,7 @@ WashBay &WashBay::operator=(const WashBay &o) {
         availMin_ = o.availMin_;
         delete [] label_;
         label_ = dup(o.label_);
-        canBasic_ = o.canBasic_;
-        canDeluxe_ = o.canDeluxe_;
-        canWax_ = o.canWax_;
+        caps_ = o.caps_;
     }
     return *this;
 }
@@ -39,19 +38,41 @@ WashBay::~WashBay() {
 }
 
 bool WashBay::canDo(const std::string &n) const {
-    if (n == "Basic" || n == "basic" || n == "Eco") return canBasic_;
-    if (n == "Deluxe" || n == "deluxe") return canDeluxe_;
-    if (n == "Wax" || n == "wax") return canWax_;
+    if (n == "Basic" || n == "basic" || n == "Eco") return canDo(ServiceKind::Basic);
+    if (n == "Deluxe" || n == "deluxe") return canDo(ServiceKind::Deluxe);
+    if (n == "Wax" || n == "wax") return canDo(ServiceKind::Wax);
     return false;
 }
 
-int WashBay::bookOne(const WashService &sp, int earliest) {
+int WashBay::bookOne(const WashService &sp, int earliest, double speedFactor) {
     int start = (earliest > availMin_) ? earliest : availMin_;
-    int finish = start + sp.duration();
+    int finish = start + durationFor(sp, speedFactor);
     availMin_ = finish;
     return finish;
 }
 
+int WashBay::durationFor(const WashService &sp, double speedFactor) {
+    if (speedFactor <= 0.0) speedFactor = 1.0;
+    const int d = static_cast<int>(std::ceil(sp.duration() / speedFactor));
+    return d > 0 ? d : 1;
+}
+
+void WashBay::save(BinaryWriter &w) const {
+    w.i32(id_);
+    w.i32(availMin_);
+    w.str(label_);
+    w.u8(caps_);
+}
+
+WashBay WashBay::load(BinaryReader &r) {
+    const int id = r.i32();
+    const int avail = r.i32();
+    const std::string label = r.str();
+    WashBay b(id, avail, label);
+    b.caps_ = r.u8();
+    return b;
+}
+
 std::ostream &operator<<(std::ostream &os, const WashBay &b) {
     os << "Bay #" << b.id() << " (at=" << b.availAt() << "m, [";
     bool first = true;
@@ -1,4 +1,5 @@
 #include "../headers/WashService.h"
+#include "../headers/BinaryIO.h"
 
 #include <ostream>
 #include <utility>
@@ -19,6 +20,7 @@ WashService::WashService(std::string name, int durationMin, double price,
 void WashService::applyFactor(double factor) {
     if (factor <= 0.0) return;
     price_ *= factor;
+    ++revision_;
 }
 
 std::string WashService::kindToString(ServiceKind k) {
@@ -32,6 +34,17 @@ std::string WashService::kindToString(ServiceKind k) {
     return "Custom";
 }
 
+void WashService::save(BinaryWriter &w) const {
+    w.u8(static_cast<std::uint8_t>(kind_));
+    w.str(name_);
+    w.i32(duration_);
+    w.f64(price_);
+    w.i32(needW_);
+    w.i32(needS_);
+    w.i32(needX_);
+    w.f64(rating_);
+}
+
 void WashService::print(std::ostream &os) const {
     os << kindToString(kind_) << "("
             << name_ << ", " << duration_ << " min, "
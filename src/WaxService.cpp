@@ -1,4 +1,5 @@
 #include "../headers/WaxService.h"
+#include "../headers/BinaryIO.h"
 
 #include <algorithm>
 #include <utility>
@@ -29,6 +30,21 @@ void WaxService::enableNanoCoating(bool enabled) {
         price_ = basePrice_;
         rating_ = baseRating_;
     }
+    ++revision_;
+}
+
+void WaxService::save(BinaryWriter &w) const {
+    WashService::save(w);
+    w.boolean(nanoCoatingEnabled_);
+    w.f64(basePrice_);
+    w.f64(baseRating_);
+}
+
+void WaxService::restoreCoating(bool enabled, double basePrice, double baseRating) {
+    nanoCoatingEnabled_ = enabled;
+    basePrice_ = basePrice;
+    baseRating_ = baseRating;
+    ++revision_;
 }
 
 std::unique_ptr<WashService> WaxService::clone() const {